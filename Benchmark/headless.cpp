@@ -0,0 +1,51 @@
+/***********************************************************************
+ * Source File:
+ *    HEADLESS : OpenGL and GLUT without a window
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Every OpenGL and GLUT entry point the Skeet variants use, as
+ *    functions that do nothing. Linking against these instead of the
+ *    real libraries lets the game logic run on a machine with no display,
+ *    and keeps the graphics driver out of the measurements.
+ ************************************************************************/
+
+#include <GL/gl.h>
+#include <GL/glu.h>
+#include <GL/glut.h>
+
+// fonts are addresses of these in freeglut
+void * glutBitmapHelvetica12 = nullptr;
+void * glutBitmapHelvetica18 = nullptr;
+
+/***************************************************
+ * OPENGL
+ **************************************************/
+void glBegin(GLenum) {}
+void glEnd() {}
+void glClear(GLbitfield) {}
+void glClearColor(GLclampf, GLclampf, GLclampf, GLclampf) {}
+void glColor3f(GLfloat, GLfloat, GLfloat) {}
+void glVertex2f(GLfloat, GLfloat) {}
+void glRasterPos2f(GLfloat, GLfloat) {}
+void gluOrtho2D(GLdouble, GLdouble, GLdouble, GLdouble) {}
+
+/***************************************************
+ * GLUT
+ **************************************************/
+void glutInit(int *, char **) {}
+void glutInitWindowSize(int, int) {}
+void glutInitWindowPosition(int, int) {}
+void glutInitDisplayMode(unsigned int) {}
+int  glutCreateWindow(const char *) { return 1; }
+void glutReshapeWindow(int, int) {}
+void glutIgnoreKeyRepeat(int) {}
+void glutDisplayFunc(void (*)(void)) {}
+void glutIdleFunc(void (*)(void)) {}
+void glutKeyboardFunc(void (*)(unsigned char, int, int)) {}
+void glutSpecialFunc(void (*)(int, int, int)) {}
+void glutSpecialUpFunc(void (*)(int, int, int)) {}
+void glutMainLoop() {}
+void glutSwapBuffers() {}
+void glutBitmapCharacter(void *, int) {}
+int  glutGetModifiers() { return 0; }
@@ -0,0 +1,311 @@
+/***********************************************************************
+ * Source File:
+ *    PATTERN BENCH : What each design pattern costs at runtime
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Drive one Skeet variant's game logic, without a window, through a
+ *    seeded, scripted game. This file is compiled against each variant
+ *    in turn (see run.sh) so they all see exactly the same workload.
+ *    Reports time per frame, heap allocations, the most heap in use at
+ *    once, and, where the operating system allows it, instructions and
+ *    cache misses per frame.
+ *
+ *    A variant that shares its work out to a JobSystem gets one of the
+ *    size asked for, one thread (no workers) unless told otherwise, so it
+ *    is compared on the same footing as the rest. The others always
+ *    report one thread.
+ ************************************************************************/
+
+#include "skeet.h"
+#include "uiInteract.h"
+#if __has_include("jobSystem.h")
+#define HAS_JOB_SYSTEM
+#endif
+#include <GL/glut.h>      // for the GLUT_KEY_ constants
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#define PERF_COUNT_HW_INSTRUCTIONS 1
+#define PERF_COUNT_HW_CACHE_MISSES 3
+#endif // __linux__
+
+/***************************************************
+ * ALLOCATION COUNTING
+ * Every new in the program comes through here, arrays and
+ * over-aligned blocks included. Each block carries its size
+ * in front, so a delete knows how much is no longer in use.
+ * A variant with worker threads allocates from them too, so
+ * the counts are atomic.
+ **************************************************/
+static std::atomic<unsigned long long> numAllocations(0);
+static std::atomic<unsigned long long> numBytes(0);
+static std::atomic<unsigned long long> bytesInUse(0);
+static std::atomic<unsigned long long> peakBytesInUse(0);
+
+// keeps the block after it as aligned as malloc() made it
+const size_t HEADER = alignof(std::max_align_t);
+
+static void countNew(size_t size)
+{
+   numAllocations.fetch_add(1, std::memory_order_relaxed);
+   numBytes.fetch_add(size, std::memory_order_relaxed);
+   unsigned long long inUse = bytesInUse.fetch_add(size, std::memory_order_relaxed) + size;
+   unsigned long long peak = peakBytesInUse.load(std::memory_order_relaxed);
+   while (inUse > peak &&
+          !peakBytesInUse.compare_exchange_weak(peak, inUse, std::memory_order_relaxed))
+      ;
+}
+static void countDelete(void * p)
+{
+   bytesInUse.fetch_sub(*((size_t *)p - 1), std::memory_order_relaxed);
+}
+
+void * operator new(size_t size)
+{
+   countNew(size);
+   char * p = (char *)malloc(HEADER + size);
+   if (!p)
+      throw std::bad_alloc();
+   *(size_t *)(p + HEADER - sizeof(size_t)) = size;
+   return p + HEADER;
+}
+void operator delete(void * p) noexcept
+{
+   if (!p)
+      return;
+   countDelete(p);
+   free((char *)p - HEADER);
+}
+void * operator new[](size_t size)               { return operator new(size); }
+void operator delete[](void * p) noexcept        { operator delete(p); }
+void operator delete(void * p, size_t) noexcept   { operator delete(p); }
+void operator delete[](void * p, size_t) noexcept { operator delete(p); }
+
+// an over-aligned block has a whole alignment in front for its size
+void * operator new(size_t size, std::align_val_t align)
+{
+   countNew(size);
+   size_t front = std::max((size_t)align, HEADER);
+   size_t whole = (front + size + (size_t)align - 1) / (size_t)align * (size_t)align;
+#ifdef _WIN32
+   char * p = (char *)_aligned_malloc(whole, (size_t)align);
+#else
+   char * p = (char *)aligned_alloc((size_t)align, whole);
+#endif // _WIN32
+   if (!p)
+      throw std::bad_alloc();
+   *(size_t *)(p + front - sizeof(size_t)) = size;
+   return p + front;
+}
+void operator delete(void * p, std::align_val_t align) noexcept
+{
+   if (!p)
+      return;
+   countDelete(p);
+   char * block = (char *)p - std::max((size_t)align, HEADER);
+#ifdef _WIN32
+   _aligned_free(block);
+#else
+   free(block);
+#endif // _WIN32
+}
+void * operator new[](size_t size, std::align_val_t align)
+{
+   return operator new(size, align);
+}
+void operator delete[](void * p, std::align_val_t align) noexcept
+{
+   operator delete(p, align);
+}
+void operator delete(void * p, size_t, std::align_val_t align) noexcept
+{
+   operator delete(p, align);
+}
+void operator delete[](void * p, size_t, std::align_val_t align) noexcept
+{
+   operator delete(p, align);
+}
+
+/***************************************************
+ * PERF COUNTER
+ * A hardware counter for this process. If the kernel will
+ * not give us one (containers, virtual machines, macOS) the
+ * counter simply reports that it is unavailable.
+ **************************************************/
+class PerfCounter
+{
+public:
+   PerfCounter(unsigned long long config) : fd(-1)
+   {
+#ifdef __linux__
+      perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = config;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif // __linux__
+   }
+   ~PerfCounter()
+   {
+#ifdef __linux__
+      if (fd >= 0)
+         close(fd);
+#endif // __linux__
+   }
+
+   bool isAvailable() const { return fd >= 0; }
+
+   void start()
+   {
+#ifdef __linux__
+      if (fd >= 0)
+      {
+         ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+         ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif // __linux__
+   }
+
+   unsigned long long stop()
+   {
+      unsigned long long count = 0;
+#ifdef __linux__
+      if (fd >= 0)
+      {
+         ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+         if (read(fd, &count, sizeof(count)) != sizeof(count))
+            count = 0;
+      }
+#endif // __linux__
+      return count;
+   }
+
+private:
+   int fd;
+};
+
+/***************************************************
+ * PRESS
+ * Tell the interface a key went up or down, just as
+ * the GLUT callbacks would
+ **************************************************/
+static void press(int key, bool isDown)
+{
+   UserInput ui;
+   ui.keyEvent(key, isDown);
+}
+
+/***************************************************
+ * SCRIPT
+ * The same player for every variant: sweep the gun back and
+ * forth a second and a half at a time, fire a pellet every fourth
+ * frame, a missile every second, and a bomb every second and a half.
+ * Space also starts a new game when the last one ends.
+ **************************************************/
+static void script(int frame)
+{
+   bool isSweepingUp = (frame / 45) % 2 == 0;
+   if (frame % 45 == 0)
+   {
+      press(GLUT_KEY_UP,    isSweepingUp);
+      press(GLUT_KEY_DOWN, !isSweepingUp);
+   }
+   if (frame % 4 == 0)
+      press(' ', true);
+   if (frame % 30 == 0)
+      press('m', true);
+   if (frame % 45 == 0)
+      press('b', true);
+}
+
+/***************************************************
+ * MAIN
+ *    patternBench <variant> [frames] [seed] [threads]
+ * Prints one comma-separated line of results
+ **************************************************/
+int main(int argc, char ** argv)
+{
+   const char * variant = argc > 1 ? argv[1] : "skeet";
+   int numFrames = argc > 2 ? atoi(argv[2]) : 9000;
+   unsigned int seed = argc > 3 ? (unsigned int)atoi(argv[3]) : 42;
+   unsigned int numThreads = argc > 4 ? (unsigned int)atoi(argv[4]) : 1;
+
+   srand(seed);
+   Position dimensions(800.0, 800.0);
+#ifdef HAS_JOB_SYSTEM
+   JobSystem jobs(numThreads);
+   numThreads = jobs.size();
+   Skeet skeet(dimensions, jobs);
+#else
+   numThreads = 1;
+   Skeet skeet(dimensions);
+#endif // HAS_JOB_SYSTEM
+   UserInput ui;
+
+   PerfCounter instructions(PERF_COUNT_HW_INSTRUCTIONS);
+   PerfCounter cacheMisses(PERF_COUNT_HW_CACHE_MISSES);
+   std::vector<double> microseconds;
+   microseconds.reserve(numFrames);
+
+   unsigned long long allocationsBefore = numAllocations;
+   unsigned long long bytesBefore = numBytes;
+   peakBytesInUse = bytesInUse.load();
+   instructions.start();
+   cacheMisses.start();
+   for (int frame = 0; frame < numFrames; frame++)
+   {
+      script(frame);
+      auto start = std::chrono::steady_clock::now();
+      skeet.interact(ui);
+      skeet.animate();
+      auto end = std::chrono::steady_clock::now();
+      ui.keyEvent();
+      microseconds.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+   }
+   unsigned long long numMisses = cacheMisses.stop();
+   unsigned long long numInstructions = instructions.stop();
+   unsigned long long allocations = numAllocations - allocationsBefore;
+   unsigned long long bytes = numBytes - bytesBefore;
+
+   // summarize the frame times
+   double total = 0.0;
+   for (double us : microseconds)
+      total += us;
+   std::sort(microseconds.begin(), microseconds.end());
+   double p50 = microseconds[microseconds.size() / 2];
+   double p99 = microseconds[microseconds.size() * 99 / 100];
+
+   // variant,frames,threads,mean_us,p50_us,p99_us,allocs/frame,bytes/frame,instr/frame,misses/frame,peak_kb
+   printf("%s,%d,%u,%.3f,%.3f,%.3f,%.2f,%.1f,", variant, numFrames, numThreads,
+          total / numFrames, p50, p99,
+          (double)allocations / numFrames, (double)bytes / numFrames);
+   if (instructions.isAvailable())
+      printf("%.0f,", (double)numInstructions / numFrames);
+   else
+      printf("n/a,");
+   if (cacheMisses.isAvailable())
+      printf("%.1f,", (double)numMisses / numFrames);
+   else
+      printf("n/a,");
+   printf("%.1f\n", peakBytesInUse.load() / 1024.0);
+
+   return 0;
+}
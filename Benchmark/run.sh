@@ -0,0 +1,94 @@
+#!/bin/sh
+###########################################################################
+# RUN
+#    Build the game logic of every Skeet variant without a window and run
+#    the same seeded workload through each one. One line per variant:
+#
+#       variant,frames,threads,mean_us,p50_us,p99_us,allocs/frame,
+#       bytes/frame,instr/frame,misses/frame,peak_kb
+#
+#    peak_kb is the most heap the game had in use at once. A variant may
+#    name extra compiler flags after its directory; CommandPassingFloat32
+#    is the same game storing its state in float (SKEET_FLOAT32), and
+#    CommandPassingRuntimeLevels spawns its birds by walking the level
+#    table as if it had been read from a file (SKEET_RUNTIME_LEVELS)
+#    instead of through the routines built from it.
+#
+#    threads is how many threads a variant with a JobSystem runs on,
+#    counting its own; the rest always run on one.
+#
+#    Usage:  Benchmark/run.sh [frames] [seed] [threads]
+#    CXX, CXXFLAGS, and OUT (the build directory) may be overridden.
+###########################################################################
+
+FRAMES=${1:-9000}
+SEED=${2:-42}
+THREADS=${3:-1}
+CXX=${CXX:-g++}
+# the older variants initialize their members out of order, and say so
+# at every include of their skeet.h
+CXXFLAGS=${CXXFLAGS:--std=c++17 -O2 -Wall -Wno-reorder}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT=${OUT:-/tmp/skeetBench}
+
+VARIANTS="
+SkeetClean:Lab06-MessagePassing/SkeetClean
+Strategy:SkeetAlgorithmAbstraction/Strategy
+Decorator:SkeetAlgorithmAbstraction/Decorator
+Visitor:Lab06-MessagePassing/Visitor/Skeet
+Mediator:Lab06-MessagePassing/Mediator/Skeet
+Observer:Lab06-MessagePassing/Observer/Skeet
+ChainOfResponsibility:Lab06-MessagePassing/ChainOfResponsibility/Skeet
+SeparationOfConcerns:Lab08-SeparationOfConcerns/Skeet
+CommandPassing:Lab10-CommandPassing/Skeet
+CommandPassingFloat32:Lab10-CommandPassing/Skeet:-DSKEET_FLOAT32
+CommandPassingRuntimeLevels:Lab10-CommandPassing/Skeet:-DSKEET_RUNTIME_LEVELS
+"
+
+mkdir -p "$OUT"
+$CXX $CXXFLAGS -c "$ROOT/Benchmark/headless.cpp" -o "$OUT/headless.o" || exit 1
+
+echo "variant,frames,threads,mean_us,p50_us,p99_us,allocs/frame,bytes/frame,instr/frame,misses/frame,peak_kb"
+for entry in $VARIANTS
+do
+   name=${entry%%:*}
+   rest=${entry#*:}
+   dir=$ROOT/${rest%%:*}
+   flags=
+   [ "$rest" != "${rest#*:}" ] && flags=${rest#*:}
+   build=$OUT/$name
+   mkdir -p "$build"
+
+   # the Visual Studio project, when there is one, knows which files are live
+   if [ -f "$dir/Skeet.vcxproj" ]
+   then
+      sources=$(sed -n 's/.*<ClCompile Include="\([^"]*\.cpp\)".*/\1/p' "$dir/Skeet.vcxproj")
+   else
+      sources=$(cd "$dir" && ls *.cpp)
+   fi
+
+   # game.cpp holds the static members; its main() is renamed out of the way
+   objects=""
+   failed=""
+   for source in $sources
+   do
+      object=$build/${source%.cpp}.o
+      if [ "$source" = "game.cpp" ]
+      then
+         define=-Dmain=gameMain
+      else
+         define=
+      fi
+      (cd "$dir" && $CXX $CXXFLAGS $flags $define -c "$source" -o "$object") || failed=yes
+      objects="$objects $object"
+   done
+   $CXX $CXXFLAGS $flags -iquote "$dir" -c "$ROOT/Benchmark/patternBench.cpp" -o "$build/patternBench.o" || failed=yes
+
+   if [ -n "$failed" ] ||
+      ! $CXX $objects "$build/patternBench.o" "$OUT/headless.o" -o "$build/patternBench"
+   then
+      echo "$name,build failed"
+      continue
+   fi
+   "$build/patternBench" "$name" "$FRAMES" "$SEED" "$THREADS"
+done
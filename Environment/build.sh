@@ -0,0 +1,44 @@
+#!/bin/sh
+###########################################################################
+# BUILD
+#    Build the batched Skeet environment from the Lab10 game logic with
+#    NO_GRAPHICS defined, so nothing needs OpenGL or GLUT:
+#
+#       libskeetEnv.a    link into a C or C++ program, with -lstdc++ -lpthread
+#       libskeetEnv.so   load from anything that speaks C (Python ctypes...)
+#       envBench         game frames per second, see envBench.c
+#       tournament       whole games played by the autopilot, see tournament.cpp
+#
+#    Usage:  Environment/build.sh
+#    CXX, CC, CXXFLAGS, and OUT (the build directory) may be overridden.
+#    Add -DSKEET_FLOAT32 to CXXFLAGS to store the game state in float.
+###########################################################################
+
+CXX=${CXX:-g++}
+CC=${CC:-gcc}
+CXXFLAGS=${CXXFLAGS:--std=c++17 -O2}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT=${OUT:-/tmp/skeetEnv}
+GAME=$ROOT/Lab10-CommandPassing/Skeet
+
+# just the game logic: no window, no input, no drawing thread
+SOURCES="arena autopilot bird bullet census dice effect gun jobSystem levels points position score skeet time trajectory tuning"
+
+mkdir -p "$OUT"
+objects=""
+for source in $SOURCES
+do
+   $CXX $CXXFLAGS -fPIC -DNO_GRAPHICS -iquote "$GAME" -c "$GAME/$source.cpp" -o "$OUT/$source.o" || exit 1
+   objects="$objects $OUT/$source.o"
+done
+$CXX $CXXFLAGS -fPIC -DNO_GRAPHICS -iquote "$GAME" -c "$ROOT/Environment/environment.cpp" \
+   -o "$OUT/environment.o" || exit 1
+objects="$objects $OUT/environment.o"
+
+rm -f "$OUT/libskeetEnv.a"
+ar rcs "$OUT/libskeetEnv.a" $objects || exit 1
+$CXX -shared $objects -o "$OUT/libskeetEnv.so" -lpthread || exit 1
+$CC -O2 -std=c11 -c "$ROOT/Environment/envBench.c" -o "$OUT/envBench.o" || exit 1
+$CXX "$OUT/envBench.o" "$OUT/libskeetEnv.a" -o "$OUT/envBench" -lpthread || exit 1
+$CXX $CXXFLAGS -DNO_GRAPHICS -iquote "$GAME" "$ROOT/Environment/tournament.cpp" \
+   "$OUT/libskeetEnv.a" -o "$OUT/tournament" -lpthread || exit 1
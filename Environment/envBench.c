@@ -0,0 +1,75 @@
+/***********************************************************************
+ * Source File:
+ *    ENV BENCH : How many game frames a second the environment can do
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Plain C, to keep the C API honest. Steps a batch of games with a
+ *    random player for a while and reports game frames per second.
+ *       envBench [games] [steps] [threads] [seed]
+ ************************************************************************/
+
+#include "skeetEnv.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/***************************************************
+ * NOW
+ * Wall clock seconds
+ **************************************************/
+static double now(void)
+{
+   struct timespec ts;
+   timespec_get(&ts, TIME_UTC);
+   return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/***************************************************
+ * MAIN
+ **************************************************/
+int main(int argc, char ** argv)
+{
+   int numGames = argc > 1 ? atoi(argv[1]) : 4096;
+   int numSteps = argc > 2 ? atoi(argv[2]) : 1000;
+   int numThreads = argc > 3 ? atoi(argv[3]) : 0;
+   unsigned long long seed = argc > 4 ? strtoull(argv[4], NULL, 10) : 42;
+
+   SkeetEnv * env = skeetEnvCreate(numGames, seed, numThreads);
+   if (!env)
+   {
+      fprintf(stderr, "unable to create %d games\n", numGames);
+      return 1;
+   }
+
+   unsigned char * actions = (unsigned char *)malloc(numGames);
+   SkeetObservation observation;
+   long long totalScore = 0;
+   int i;
+   int step;
+
+   // turn at random, fire a pellet one frame in four
+   srand((unsigned int)seed);
+   double start = now();
+   for (step = 0; step < numSteps; step++)
+   {
+      for (i = 0; i < numGames; i++)
+         actions[i] = (unsigned char)((rand() % 3) | (rand() % 4 == 0 ? SKEET_FIRE_PELLET : 0));
+      skeetEnvStep(env, actions);
+   }
+   double seconds = now() - start;
+
+   skeetEnvObserve(env, &observation);
+   for (i = 0; i < observation.numGames; i++)
+      totalScore += observation.score[i];
+
+   printf("games:         %d\n", numGames);
+   printf("steps:         %d\n", numSteps);
+   printf("seconds:       %.3f\n", seconds);
+   printf("frames/second: %.0f\n", (double)numGames * numSteps / seconds);
+   printf("mean score:    %.2f\n", (double)totalScore / numGames);
+
+   free(actions);
+   skeetEnvDestroy(env);
+   return 0;
+}
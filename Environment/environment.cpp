@@ -0,0 +1,209 @@
+/***********************************************************************
+ * Source File:
+ *    ENVIRONMENT : Many games of Skeet at once
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    A batch of independent Skeet games, each with its own dice so they
+ *    can run on any thread and still play out exactly as seeded. A step
+ *    moves every game one frame across the job system, then copies what
+ *    each game looks like into flat arrays, one row per game. The C API
+ *    in skeetEnv.h is a thin wrapper at the bottom of this file.
+ ************************************************************************/
+
+#include "environment.h"
+#include <algorithm>
+#include <new>
+using namespace std;
+
+#define WIDTH  800.0
+#define HEIGHT 800.0
+
+Position Bullet::dimensions(WIDTH, HEIGHT);
+Position Bird::dimensions(WIDTH, HEIGHT);
+
+// how many games one job steps at a time
+const size_t GAMES_PER_JOB = 32;
+
+/*********************************************
+ * ENVIRONMENT constructor
+ * Every game gets its own dice, all from the one seed
+ *********************************************/
+Environment::Environment(int numGames, unsigned long long seed, unsigned int numThreads) :
+   dimensions(WIDTH, HEIGHT), jobs(numThreads), inPlace(1),
+   commands(numGames),
+   birdX(numGames * SKEET_MAX_BIRDS),  birdY(numGames * SKEET_MAX_BIRDS),
+   birdDx(numGames * SKEET_MAX_BIRDS), birdDy(numGames * SKEET_MAX_BIRDS),
+   numBirds(numGames), gunAngle(numGames), score(numGames), level(numGames)
+{
+   Dice seeder(seed);
+   for (int game = 0; game < numGames; game++)
+   {
+      unsigned long long high = (unsigned long long)seeder.roll();
+      dice.push_back(Dice((high << 31) ^ (unsigned long long)seeder.roll()));
+      games.push_back(unique_ptr<Skeet>(new Skeet(dimensions, inPlace)));
+      observe(game);
+   }
+}
+
+/*********************************************
+ * ENVIRONMENT : RESET
+ * A fresh game, still rolling the same dice
+ *********************************************/
+void Environment::reset(int game)
+{
+   if (game < 0)
+   {
+      for (int i = 0; i < size(); i++)
+         reset(i);
+      return;
+   }
+   assert(game < size());
+   games[game].reset(new Skeet(dimensions, inPlace));
+   observe(game);
+}
+
+/*********************************************
+ * ENVIRONMENT : STEP
+ * Every game, one frame, on every core
+ *********************************************/
+void Environment::step(const unsigned char * actions)
+{
+   jobs.parallelFor(games.size(), GAMES_PER_JOB, [&](size_t begin, size_t end)
+   {
+      for (size_t game = begin; game < end; game++)
+      {
+         Dice::Use use(dice[game]);
+         Skeet & skeet = *games[game];
+         translate(actions[game], skeet.getFrame(), commands[game]);
+         skeet.execute(commands[game]);
+         skeet.animate();
+         observe((int)game);
+      }
+   });
+}
+
+/*********************************************
+ * ENVIRONMENT : TRANSLATE
+ * An action byte into the same commands the keyboard makes
+ *********************************************/
+void Environment::translate(unsigned char action, unsigned int frame,
+                            vector<Command> & commands)
+{
+   commands.clear();
+
+   unsigned char held = (action & SKEET_TURN_FAST) ? 11 : 1;
+   unsigned char clockwise        = (action & SKEET_TURN_CLOCKWISE)        ? held : 0;
+   unsigned char counterclockwise = (action & SKEET_TURN_COUNTERCLOCKWISE) ? held : 0;
+   if (clockwise || counterclockwise)
+   {
+      commands.push_back({ frame, ROTATE_GUN, clockwise, counterclockwise });
+      commands.push_back({ frame, STEER_MISSILE,
+                           (unsigned char)(clockwise != 0),
+                           (unsigned char)(counterclockwise != 0) });
+   }
+   if (action & SKEET_FIRE_PELLET)
+      commands.push_back({ frame, FIRE_PELLET, 0, 0 });
+   if (action & SKEET_FIRE_MISSILE)
+      commands.push_back({ frame, FIRE_MISSILE, 0, 0 });
+   if (action & SKEET_FIRE_BOMB)
+      commands.push_back({ frame, FIRE_BOMB, 0, 0 });
+}
+
+/*********************************************
+ * ENVIRONMENT : OBSERVE
+ * Copy one game into its row of the arrays
+ *********************************************/
+void Environment::observe(int game)
+{
+   const Skeet & skeet = *games[game];
+   size_t row = (size_t)game * SKEET_MAX_BIRDS;
+   int count = 0;
+
+   skeet.getBirds().forEach([&](const auto & element)
+   {
+      if (count == SKEET_MAX_BIRDS || element.isDead())
+         return;
+      Position pt = element.getPosition();
+      Velocity v = element.getVelocity();
+      birdX [row + count] = (float)pt.getX();
+      birdY [row + count] = (float)pt.getY();
+      birdDx[row + count] = (float)v.getDx();
+      birdDy[row + count] = (float)v.getDy();
+      count++;
+   });
+   for (int i = count; i < SKEET_MAX_BIRDS; i++)
+      birdX[row + i] = birdY[row + i] = birdDx[row + i] = birdDy[row + i] = 0.0f;
+
+   numBirds[game] = count;
+   gunAngle[game] = (float)skeet.getGunAngle();
+   score[game]    = skeet.getScore();
+   level[game]    = skeet.getLevel();
+}
+
+/*********************************************
+ * ENVIRONMENT : OBSERVE
+ * Where the arrays are
+ *********************************************/
+void Environment::observe(SkeetObservation & observation) const
+{
+   observation.numGames = size();
+   observation.birdX    = birdX.data();
+   observation.birdY    = birdY.data();
+   observation.birdDx   = birdDx.data();
+   observation.birdDy   = birdDy.data();
+   observation.numBirds = numBirds.data();
+   observation.gunAngle = gunAngle.data();
+   observation.score    = score.data();
+   observation.level    = level.data();
+}
+
+/***************************************************************/
+/***************************************************************/
+/*                            C API                            */
+/***************************************************************/
+/***************************************************************/
+
+struct SkeetEnv : public Environment
+{
+   using Environment::Environment;
+};
+
+SkeetEnv * skeetEnvCreate(int numGames, unsigned long long seed, int numThreads)
+{
+   if (numGames <= 0 || numThreads < 0)
+      return nullptr;
+   try
+   {
+      return new SkeetEnv(numGames, seed, (unsigned int)numThreads);
+   }
+   catch (...)
+   {
+      return nullptr;
+   }
+}
+
+void skeetEnvDestroy(SkeetEnv * env)
+{
+   delete env;
+}
+
+int skeetEnvSize(const SkeetEnv * env)
+{
+   return env->size();
+}
+
+void skeetEnvReset(SkeetEnv * env, int game)
+{
+   env->reset(game);
+}
+
+void skeetEnvStep(SkeetEnv * env, const unsigned char * actions)
+{
+   env->step(actions);
+}
+
+void skeetEnvObserve(const SkeetEnv * env, SkeetObservation * observation)
+{
+   env->observe(*observation);
+}
@@ -0,0 +1,64 @@
+/***********************************************************************
+ * Header File:
+ *    ENVIRONMENT : Many games of Skeet at once
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    A batch of independent Skeet games, each with its own dice so they
+ *    can run on any thread and still play out exactly as seeded. A step
+ *    moves every game one frame across the job system, then copies what
+ *    each game looks like into flat arrays, one row per game.
+ ************************************************************************/
+
+#pragma once
+
+#include "skeetEnv.h"
+#include "skeet.h"
+#include "dice.h"
+#include "jobSystem.h"
+
+#include <memory>
+#include <vector>
+
+/*********************************************
+ * ENVIRONMENT
+ * Skeet, N at a time
+ *********************************************/
+class Environment
+{
+public:
+   Environment(int numGames, unsigned long long seed, unsigned int numThreads = 0);
+
+   int size() const { return (int)games.size(); }
+
+   // start one game over, or all of them if game is -1
+   void reset(int game);
+
+   // move every game one frame. One SkeetAction byte per game
+   void step(const unsigned char * actions);
+
+   // where the observations are
+   void observe(SkeetObservation & observation) const;
+
+private:
+   void observe(int game);
+   static void translate(unsigned char action, unsigned int frame,
+                         std::vector<Command> & commands);
+
+   Position dimensions;                          // size of every game's screen
+   JobSystem jobs;                               // spreads the games over the cores
+   JobSystem inPlace;                            // each game's own loops stay on its thread
+   std::vector<std::unique_ptr<Skeet>> games;
+   std::vector<Dice> dice;                       // one set per game
+   std::vector<std::vector<Command>> commands;   // one frame's worth, per game
+
+   // observations: SKEET_MAX_BIRDS per game for the birds, one per game otherwise
+   std::vector<float> birdX;
+   std::vector<float> birdY;
+   std::vector<float> birdDx;
+   std::vector<float> birdDy;
+   std::vector<int>   numBirds;
+   std::vector<float> gunAngle;
+   std::vector<int>   score;
+   std::vector<int>   level;
+};
@@ -0,0 +1,81 @@
+/***********************************************************************
+ * Header File:
+ *    SKEET ENV : Many games of Skeet at once, from C
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    A batch of independent Skeet games for bots to play. Every call to
+ *    skeetEnvStep() moves all of them one frame, spread across every
+ *    core, and the observations come back in flat arrays, one row per
+ *    game. No window, no OpenGL, and no GLUT. See build.sh.
+ ************************************************************************/
+
+#ifndef SKEET_ENV_H
+#define SKEET_ENV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// how many birds each game reports. Any more than this are not seen.
+#define SKEET_MAX_BIRDS 16
+
+/*********************************************
+ * SKEET ACTION
+ * What to do with the gun this frame, one byte per game.
+ * Combine with |. Only one shot is fired per frame:
+ * pellet before missile before bomb.
+ *********************************************/
+enum SkeetAction
+{
+   SKEET_TURN_CLOCKWISE        = 1,
+   SKEET_TURN_COUNTERCLOCKWISE = 2,
+   SKEET_TURN_FAST             = 4,    // as if the key had been held a while
+   SKEET_FIRE_PELLET           = 8,    // also starts a new game when it is over
+   SKEET_FIRE_MISSILE          = 16,   // level 2 and up
+   SKEET_FIRE_BOMB             = 32    // level 3 and up
+};
+
+/*********************************************
+ * SKEET OBSERVATION
+ * Where to find what the games look like after the last step.
+ * The bird arrays have SKEET_MAX_BIRDS entries per game: game g's
+ * birds are [g * SKEET_MAX_BIRDS, g * SKEET_MAX_BIRDS + numBirds[g]).
+ * The arrays belong to the environment and stay put for its life.
+ *********************************************/
+typedef struct SkeetObservation
+{
+   int numGames;
+   const float * birdX;            // position, in pixels
+   const float * birdY;
+   const float * birdDx;           // velocity, in pixels per frame
+   const float * birdDy;
+   const int   * numBirds;         // per game
+   const float * gunAngle;         // per game, in radians
+   const int   * score;            // per game
+   const int   * level;            // per game, 0 when the game is over
+} SkeetObservation;
+
+typedef struct SkeetEnv SkeetEnv;
+
+// numThreads 0 means one per core. NULL if the games could not be made.
+SkeetEnv * skeetEnvCreate(int numGames, unsigned long long seed, int numThreads);
+void       skeetEnvDestroy(SkeetEnv * env);
+
+// how many games?
+int  skeetEnvSize(const SkeetEnv * env);
+
+// start one game over, or all of them if game is -1
+void skeetEnvReset(SkeetEnv * env, int game);
+
+// move every game one frame. actions has one SkeetAction byte per game
+void skeetEnvStep(SkeetEnv * env, const unsigned char * actions);
+
+// where the observations are
+void skeetEnvObserve(const SkeetEnv * env, SkeetObservation * observation);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SKEET_ENV_H
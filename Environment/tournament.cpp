@@ -0,0 +1,270 @@
+/***********************************************************************
+ * Source File:
+ *    TOURNAMENT : Thousands of complete games, played by the autopilot
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Play whole games, every level to the end, across every core. Game
+ *    i rolls its own dice, seeded with seed + i, so any one game can be
+ *    played again on its own. One record per game goes to stdout, as
+ *    CSV or JSON, and a summary of the distribution goes to stderr,
+ *    along with how much of the run the autopilot spent aiming and how
+ *    much arena memory each level's effects took.
+ *       tournament [games] [seed] [threads] [csv|json]
+ ************************************************************************/
+
+#include "skeet.h"
+#include "autopilot.h"
+#include "dice.h"
+#include "jobSystem.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+using namespace std;
+
+/*********************************************
+ * LEVEL RESULT
+ * How one level of one game went
+ *********************************************/
+struct LevelResult
+{
+   int score;      // points earned in this level alone
+   int killed;
+   int missed;
+   size_t arenaBytes;   // the most the level's effects took
+};
+
+/*********************************************
+ * GAME RESULT
+ * How one game went
+ *********************************************/
+struct GameResult
+{
+   unsigned long long seed;
+   unsigned int frames;
+   int score;
+   int killed;
+   int missed;
+   array<LevelResult, NUM_LEVELS + 1> levels;    // [0] is unused
+   unsigned long long solves;                     // birds the autopilot aimed at
+   double secondsSolving;                         // ... and how long that took
+};
+
+/*********************************************
+ * HIT RATIO
+ * Percent of the birds that were shot, as HitRatio shows it
+ *********************************************/
+static double hitRatio(int killed, int missed)
+{
+   return killed + missed ? 100.0 * killed / (killed + missed) : 0.0;
+}
+
+/*********************************************
+ * PLAY
+ * One whole game with its own dice
+ *********************************************/
+static GameResult play(unsigned long long seed, JobSystem & inPlace)
+{
+   Dice dice(seed);
+   Dice::Use use(dice);
+
+   Position dimensions(800.0, 800.0);
+   unique_ptr<Skeet> pSkeet(new Skeet(dimensions, inPlace));
+   Skeet & skeet = *pSkeet;
+   Autopilot autopilot;
+   vector<Command> commands;
+
+   GameResult result = {};
+   result.seed = seed;
+   int level = skeet.getLevel();
+   int score = 0;
+   int killed = 0;
+   int missed = 0;
+
+   while (!skeet.isGameOver())
+   {
+      autopilot.decide(skeet, commands);
+      skeet.execute(commands);
+      skeet.animate();
+
+      // close out a level as soon as the next one starts
+      if (skeet.getLevel() != level)
+      {
+         result.levels[level] = { skeet.getScore()  - score,
+                                  skeet.getKilled() - killed,
+                                  skeet.getMissed() - missed,
+                                  skeet.getArenaPeak(level) };
+         level  = skeet.getLevel();
+         score  = skeet.getScore();
+         killed = skeet.getKilled();
+         missed = skeet.getMissed();
+      }
+   }
+
+   result.frames = skeet.getFrame();
+   result.score  = skeet.getScore();
+   result.killed = skeet.getKilled();
+   result.missed = skeet.getMissed();
+   result.solves = autopilot.getSolves();
+   result.secondsSolving = autopilot.getSecondsSolving();
+   return result;
+}
+
+/*********************************************
+ * WRITE CSV
+ *********************************************/
+static void writeCsv(const vector<GameResult> & results)
+{
+   printf("seed,frames,score,killed,missed,hit_ratio");
+   for (int level = 1; level <= NUM_LEVELS; level++)
+      printf(",level%d_score,level%d_killed,level%d_missed,level%d_hit_ratio",
+             level, level, level, level);
+   printf("\n");
+
+   for (auto & result : results)
+   {
+      printf("%llu,%u,%d,%d,%d,%.2f", result.seed, result.frames, result.score,
+             result.killed, result.missed, hitRatio(result.killed, result.missed));
+      for (int level = 1; level <= NUM_LEVELS; level++)
+      {
+         const LevelResult & r = result.levels[level];
+         printf(",%d,%d,%d,%.2f", r.score, r.killed, r.missed, hitRatio(r.killed, r.missed));
+      }
+      printf("\n");
+   }
+}
+
+/*********************************************
+ * WRITE JSON
+ *********************************************/
+static void writeJson(const vector<GameResult> & results)
+{
+   printf("[\n");
+   for (size_t i = 0; i < results.size(); i++)
+   {
+      const GameResult & result = results[i];
+      printf("  {\"seed\": %llu, \"frames\": %u, \"score\": %d, \"killed\": %d, "
+             "\"missed\": %d, \"hit_ratio\": %.2f, \"levels\": [",
+             result.seed, result.frames, result.score, result.killed,
+             result.missed, hitRatio(result.killed, result.missed));
+      for (int level = 1; level <= NUM_LEVELS; level++)
+      {
+         const LevelResult & r = result.levels[level];
+         printf("%s{\"level\": %d, \"score\": %d, \"killed\": %d, \"missed\": %d, "
+                "\"hit_ratio\": %.2f}",
+                level > 1 ? ", " : "", level, r.score, r.killed, r.missed,
+                hitRatio(r.killed, r.missed));
+      }
+      printf("]}%s\n", i + 1 < results.size() ? "," : "");
+   }
+   printf("]\n");
+}
+
+/*********************************************
+ * SUMMARIZE
+ * Mean, spread, and percentiles of one number across every game
+ *********************************************/
+static void summarize(const char * name, vector<double> values)
+{
+   if (values.empty())
+      return;
+   double sum = 0.0;
+   for (double value : values)
+      sum += value;
+   double mean = sum / values.size();
+   double squares = 0.0;
+   for (double value : values)
+      squares += (value - mean) * (value - mean);
+   sort(values.begin(), values.end());
+
+   fprintf(stderr, "%-16s mean %8.2f  sd %7.2f  p10 %8.2f  p50 %8.2f  p90 %8.2f\n",
+           name, mean, sqrt(squares / values.size()),
+           values[values.size() / 10], values[values.size() / 2],
+           values[values.size() * 9 / 10]);
+}
+
+/*********************************************
+ * MAIN
+ *********************************************/
+int main(int argc, char ** argv)
+{
+   int numGames = argc > 1 ? atoi(argv[1]) : 1000;
+   unsigned long long seed = argc > 2 ? strtoull(argv[2], NULL, 10) : 1;
+   unsigned int numThreads = argc > 3 ? (unsigned int)atoi(argv[3]) : 0;
+   bool isJson = argc > 4 && strcmp(argv[4], "json") == 0;
+   if (numGames <= 0)
+   {
+      fprintf(stderr, "usage: tournament [games] [seed] [threads] [csv|json]\n");
+      return 1;
+   }
+
+   // one game per job; each game's own loops stay on its thread
+   JobSystem jobs(numThreads);
+   JobSystem inPlace(1);
+   vector<GameResult> results(numGames);
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   jobs.parallelFor(results.size(), 1, [&](size_t begin, size_t end)
+   {
+      for (size_t i = begin; i < end; i++)
+         results[i] = play(seed + i, inPlace);
+   });
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+   if (isJson)
+      writeJson(results);
+   else
+      writeCsv(results);
+
+   // the distributions, for a quick look
+   fprintf(stderr, "%d games, seeds %llu through %llu, %u threads\n",
+           numGames, seed, seed + numGames - 1, jobs.size());
+
+   // the autopilot's share of the run, to take out of any measurement
+   unsigned long long solves = 0;
+   double secondsSolving = 0.0;
+   for (auto & result : results)
+   {
+      solves += result.solves;
+      secondsSolving += result.secondsSolving;
+   }
+   fprintf(stderr, "aim solves:      %llu birds in %.3f s, %.2f million per second, "
+           "%.1f%% of %.3f thread-seconds of play\n",
+           solves, secondsSolving,
+           secondsSolving > 0.0 ? solves / secondsSolving / 1.0e6 : 0.0,
+           seconds > 0.0 ? 100.0 * secondsSolving / (seconds * jobs.size()) : 0.0,
+           seconds * jobs.size());
+   vector<double> values;
+   for (auto & result : results)
+      values.push_back(result.score);
+   summarize("score", values);
+   values.clear();
+   for (auto & result : results)
+      values.push_back(hitRatio(result.killed, result.missed));
+   summarize("hit ratio", values);
+   for (int level = 1; level <= NUM_LEVELS; level++)
+   {
+      char name[32];
+      values.clear();
+      for (auto & result : results)
+         values.push_back(result.levels[level].score);
+      snprintf(name, sizeof(name), "level %d score", level);
+      summarize(name, values);
+      values.clear();
+      for (auto & result : results)
+         values.push_back(hitRatio(result.levels[level].killed, result.levels[level].missed));
+      snprintf(name, sizeof(name), "level %d hits", level);
+      summarize(name, values);
+      values.clear();
+      for (auto & result : results)
+         values.push_back(result.levels[level].arenaBytes / 1024.0);
+      snprintf(name, sizeof(name), "level %d arena KB", level);
+      summarize(name, values);
+   }
+   return 0;
+}
@@ -10,6 +10,12 @@
 #pragma once
 #include "position.h"
 
+/**********************
+ * BIRD TYPE
+ * Which kind of bird this is, used to look up how a hit is handled
+ **********************/
+enum BirdType { STANDARD, FLOATER, CRAZY, SINKER, NUM_BIRD_TYPES };
+
 /**********************
  * BIRD
  * Everything that can be shot
@@ -26,6 +32,7 @@ protected:
    
 public:
    Bird() : dead(false), points(0), radius(1.0) { }
+   virtual ~Bird() { }
    
    // setters
    void operator=(const Position    & rhs) { pt = rhs;    }
@@ -48,6 +55,7 @@ public:
    // special functions
    virtual void draw() = 0;
    virtual void advance() = 0;
+   virtual BirdType getType() const = 0;
 };
 
 /*********************************************
@@ -60,6 +68,7 @@ public:
     Standard(double radius = 25.0, double speed = 5.0, int points = 10);
     void draw();
     void advance();
+    BirdType getType() const { return STANDARD; }
 };
 
 /*********************************************
@@ -72,6 +81,7 @@ public:
     Floater(double radius = 30.0, double speed = 5.0, int points = 15);
     void draw();
     void advance();
+    BirdType getType() const { return FLOATER; }
 };
 
 /*********************************************
@@ -84,6 +94,7 @@ public:
     Crazy(double radius = 30.0, double speed = 4.5, int points = 30);
     void draw();
     void advance();
+    BirdType getType() const { return CRAZY; }
 };
 
 /*********************************************
@@ -96,4 +107,5 @@ public:
     Sinker(double radius = 30.0, double speed = 4.5, int points = 20);
     void draw();
     void advance();
+    BirdType getType() const { return SINKER; }
 };
@@ -13,6 +13,12 @@
 #include <list>
 #include <cassert>
 
+/*********************************************
+ * BULLET TYPE
+ * Which kind of bullet this is, used to look up how a hit is handled
+ *********************************************/
+enum BulletType { PELLET, MISSILE, BOMB, SHRAPNEL, NUM_BULLET_TYPES };
+
 /*********************************************
  * BULLET
  * Something to shoot something else
@@ -29,6 +35,7 @@ protected:
     
 public:
    Bullet(double angle = 0.0, double speed = 30.0, double radius = 5.0, int value = 1);
+   virtual ~Bullet() {}
    
    // setters
    void kill()                   { dead = true; }
@@ -46,6 +53,7 @@ public:
    virtual void output() = 0;
    virtual void input(bool isUp, bool isDown, bool isB) {}
    virtual void move(std::list<Effect*> &effects);
+   virtual BulletType getType() const = 0;
 
 protected:
    bool isOutOfBounds() const
@@ -71,6 +79,7 @@ class Pellet : public Bullet
 public:
    Pellet(double angle, double speed = 15.0) : Bullet(angle, speed, 1.0, 1) {}
    
+   BulletType getType() const { return PELLET; }
    void output();
 };
 
@@ -85,6 +94,7 @@ private:
 public:
    Bomb(double angle, double speed = 10.0) : Bullet(angle, speed, 4.0, 4), timeToDie(60) {}
    
+   BulletType getType() const { return BOMB; }
    void output();
    void move(std::list<Effect*> & effects);
    void death(std::list<Bullet *> & bullets);
@@ -113,6 +123,7 @@ public:
       radius = 3.0;
    }
    
+   BulletType getType() const { return SHRAPNEL; }
    void output();  
    void move(std::list<Effect*> & effects);
 };
@@ -127,6 +138,7 @@ class Missile : public Bullet
 public:
    Missile(double angle, double speed = 10.0) : Bullet(angle, speed, 1.0, 3) {}
    
+   BulletType getType() const { return MISSILE; }
    void output();
    void input(bool isUp, bool isDown, bool isB)
    {
@@ -21,6 +21,7 @@ protected:
 public:
     // create a fragment based on the velocity and position of the bullet
     Effect(const Position & pt) : pt(pt), age(0.5) {}
+    virtual ~Effect() {}
     
     // draw it
     virtual void render() const = 0;
@@ -10,6 +10,11 @@
 #include "uiInteract.h"
 #include "skeet.h"
 #include "position.h"
+#include "hitHandler.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
 
 #define WIDTH  800.0
 #define HEIGHT 800.0
@@ -43,6 +48,88 @@ void callBack(const UserInput* pUI, void* p)
       pSkeet->drawStatus();
 }
 
+/*************************************
+ * BENCHMARK HITS
+ * How many hits per second can the chain handle? Every bullet in a
+ * heavy shrapnel load is handed a bird, both through the compiled
+ * dispatch table and by walking the chain link by link. Only the
+ * dispatch is timed; the fragments the hits ask for are made, and
+ * timed, after.
+ **************************************/
+void benchmarkHits(int rounds)
+{
+   const int numBombs = 50;     // each one breaks into 20 pieces
+   const int numBirds = 250;
+   HitRatio hitRatio;
+   HitChain chain;
+   Skeet::buildHitChain(chain, hitRatio);
+
+   double seconds[2] = { 0.0, 0.0 };
+   long long hits[2] = { 0, 0 };
+   double secondsFragments = 0.0;
+   long long numFragments = 0;
+   for (int r = 0; r < rounds; r++)
+      for (int compiled = 0; compiled < 2; compiled++)
+      {
+         // a screen full of birds and a sky full of shrapnel
+         std::vector<Bird *> birds;
+         for (int i = 0; i < numBirds; i++)
+            switch (i % 4)
+            {
+               case 0: birds.push_back(new Standard(15.0, 4.0, 18)); break;
+               case 1: birds.push_back(new Sinker  (15.0, 3.5, 25)); break;
+               case 2: birds.push_back(new Floater (15.0, 4.0, 25)); break;
+               case 3: birds.push_back(new Crazy   (15.0));          break;
+            }
+         std::list<Bullet *> bullets;
+         for (int i = 0; i < numBombs; i++)
+         {
+            Bomb bomb(0.1 + i / (double)numBombs);
+            bomb.death(bullets);
+            bullets.push_back(new Pellet(0.78));
+            bullets.push_back(new Missile(0.78));
+            bullets.push_back(new Bomb(0.78));
+         }
+         std::vector<Bullet *> shots(bullets.begin(), bullets.end());
+         std::vector<Blast> blasts;
+         blasts.reserve(shots.size());
+         std::list<Effect *> effects;
+
+         // every bullet hits the next bird in turn, standing or not, so
+         // each round dispatches the same pairs the same number of times
+         auto start = std::chrono::steady_clock::now();
+         int i = 0;
+         for (auto bullet : shots)
+         {
+            Bird * bird = birds[i++ % numBirds];
+            Hit hit = { *bird, *bullet, blasts };
+            if (compiled)
+               chain.handle(hit);
+            else
+               chain.walk(hit);
+            bird->setPoints(10);
+            hits[compiled]++;
+         }
+         seconds[compiled] += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+
+         start = std::chrono::steady_clock::now();
+         makeFragments(blasts, effects);
+         secondsFragments += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+         numFragments += effects.size();
+
+         for (auto p : birds)   delete p;
+         for (auto p : bullets) delete p;
+         for (auto p : effects) delete p;
+      }
+
+   std::cout << "hits per round:          " << hits[1] / rounds << "\n"
+             << "linked chain hits/sec:   " << hits[0] / seconds[0] << "\n"
+             << "dispatch table hits/sec: " << hits[1] / seconds[1] << "\n"
+             << "fragments made/sec:      " << numFragments / secondsFragments << std::endl;
+}
+
 /*********************************
  * Main is pretty sparse.  Just initialize
  * my Skkeep type and call the display engine.
@@ -59,6 +146,13 @@ int WINAPI wWinMain(
 int main(int argc, char** argv)
 #endif // !_WIN32
 {
+   // skeet --bench-hits [rounds] : measure the hit chain without a window
+   if (argc > 1 && std::string(argv[1]) == "--bench-hits")
+   {
+      benchmarkHits(argc > 2 ? std::stoi(argv[2]) : 200);
+      return 0;
+   }
+
    // initialize OpenGL
    Position dimensions(WIDTH, HEIGHT);
    UserInput ui(0, NULL,
@@ -0,0 +1,150 @@
+/***********************************************************************
+ * Source File:
+ *    HIT HANDLER : Everything that happens when a bullet hits a bird
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Each consequence of a hit (the explosion, the score, the hit ratio,
+ *    the kill, the bomb going off) is a handler in a chain. Handlers
+ *    register for the (bird type, bullet type) pairs they care about, and
+ *    the chain is compiled into a table so a hit only visits the relevant
+ *    handlers. A handler only asks for fragments; they are made once every
+ *    hit of the frame has been handled.
+ ************************************************************************/
+
+#include "hitHandler.h"
+#include <algorithm>
+
+/*********************************************
+ * MAKE FRAGMENTS
+ * Every fragment the blasts asked for
+ *********************************************/
+void makeFragments(const std::vector<Blast> & blasts, std::list<Effect*> & effects)
+{
+   for (auto & blast : blasts)
+      for (int i = 0; i < blast.numFragments; i++)
+         effects.push_back(new Fragment(blast.pt, blast.v));
+}
+
+/*********************************************
+ * EFFECTS HANDLER
+ * The bird explodes into fragments
+ *********************************************/
+void EffectsHandler::handle(Hit & hit)
+{
+   hit.blasts.push_back({ hit.bullet.getPosition(), hit.bullet.getVelocity(), numFragments });
+}
+
+/*********************************************
+ * KILL HANDLER
+ * The bird dies and the bullet is spent
+ *********************************************/
+void KillHandler::handle(Hit & hit)
+{
+   hit.bird.kill();
+   hit.bullet.kill();
+}
+
+/*********************************************
+ * BOMB DETONATION HANDLER
+ * The blast stands still where the bomb was
+ *********************************************/
+void BombDetonationHandler::handle(Hit & hit)
+{
+   hit.blasts.push_back({ hit.bullet.getPosition(), Velocity(), numFragments });
+   hit.bird.kill();
+   hit.bullet.kill();
+}
+
+/*********************************************
+ * HIT RATIO HANDLER
+ * Count the bird as hit
+ *********************************************/
+void HitRatioHandler::handle(Hit &)
+{
+   hitRatio.adjust(1);
+}
+
+/*********************************************
+ * SCORING HANDLER
+ * The bird's points move onto the bullet
+ *********************************************/
+void ScoringHandler::handle(Hit & hit)
+{
+   hit.bullet.setValue(-(hit.bird.getPoints()));
+   hit.bird.setPoints(0);
+}
+
+/*********************************************
+ * HIT CHAIN : ADD
+ * Register a handler. The chain takes ownership; registering the
+ * same handler for several pairs is fine.
+ *********************************************/
+void HitChain::add(HitHandler * pHandler, BirdType bird, BulletType bullet)
+{
+   link(pHandler, (int)bird, (int)bullet);
+}
+void HitChain::add(HitHandler * pHandler)
+{
+   link(pHandler, -1, -1);
+}
+void HitChain::link(HitHandler * pHandler, int bird, int bullet)
+{
+   assert(pHandler);
+   auto it = std::find_if(handlers.begin(), handlers.end(),
+      [pHandler](const std::unique_ptr<HitHandler> & p) { return p.get() == pHandler; });
+   if (it == handlers.end())
+      handlers.push_back(std::unique_ptr<HitHandler>(pHandler));
+
+   chain.push_back({ pHandler, bird, bullet });
+   compiled = false;
+}
+
+/*********************************************
+ * HIT CHAIN : COMPILE
+ * Flatten the chain into one short list per (bird, bullet) pair,
+ * keeping the order the handlers were registered in
+ *********************************************/
+void HitChain::compile()
+{
+   for (int bird = 0; bird < NUM_BIRD_TYPES; bird++)
+      for (int bullet = 0; bullet < NUM_BULLET_TYPES; bullet++)
+      {
+         table[bird][bullet].clear();
+         for (auto & link : chain)
+            if ((link.bird   == -1 || link.bird   == bird) &&
+                (link.bullet == -1 || link.bullet == bullet))
+               table[bird][bullet].push_back(link.pHandler);
+      }
+   compiled = true;
+}
+
+/*********************************************
+ * HIT CHAIN : HANDLE
+ * Visit only the handlers for this pair
+ *********************************************/
+void HitChain::handle(Hit & hit) const
+{
+   if (!compiled)
+   {
+      walk(hit);
+      return;
+   }
+
+   for (auto pHandler : table[hit.bird.getType()][hit.bullet.getType()])
+      pHandler->handle(hit);
+}
+
+/*********************************************
+ * HIT CHAIN : WALK
+ * The classic chain: every link checks whether the hit is its business
+ *********************************************/
+void HitChain::walk(Hit & hit) const
+{
+   int bird = hit.bird.getType();
+   int bullet = hit.bullet.getType();
+   for (auto & link : chain)
+      if ((link.bird   == -1 || link.bird   == bird) &&
+          (link.bullet == -1 || link.bullet == bullet))
+         link.pHandler->handle(hit);
+}
@@ -0,0 +1,165 @@
+/***********************************************************************
+ * Header File:
+ *    HIT HANDLER : Everything that happens when a bullet hits a bird
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Each consequence of a hit (the explosion, the score, the hit ratio,
+ *    the kill, the bomb going off) is a handler in a chain. Handlers
+ *    register for the (bird type, bullet type) pairs they care about, and
+ *    the chain is compiled into a table so a hit only visits the relevant
+ *    handlers. A handler only asks for fragments; they are made once every
+ *    hit of the frame has been handled.
+ ************************************************************************/
+
+#pragma once
+
+#include "bird.h"
+#include "bullet.h"
+#include "effect.h"
+#include "score.h"
+#include <list>
+#include <vector>
+#include <memory>
+
+/*********************************************
+ * BLAST
+ * Fragments to throw, where and how a hit asked for them
+ *********************************************/
+struct Blast
+{
+   Position pt;
+   Velocity v;                     // what the fragments are carried along by
+   int numFragments;
+};
+
+// make the fragments of every blast
+void makeFragments(const std::vector<Blast> & blasts, std::list<Effect*> & effects);
+
+/*********************************************
+ * HIT
+ * The request passed down the chain
+ *********************************************/
+struct Hit
+{
+   Bird   & bird;                  // what got shot
+   Bullet & bullet;                // what shot it
+   std::vector<Blast> & blasts;    // where the explosion goes
+};
+
+/*********************************************
+ * HIT HANDLER
+ * One link in the chain
+ *********************************************/
+class HitHandler
+{
+public:
+   virtual ~HitHandler() {}
+   virtual void handle(Hit & hit) = 0;
+};
+
+/*********************************************
+ * EFFECTS HANDLER
+ * The bird explodes into fragments, carried along the
+ * way the bullet was going
+ *********************************************/
+class EffectsHandler : public HitHandler
+{
+public:
+   EffectsHandler(int numFragments = 25) : numFragments(numFragments) {}
+   void handle(Hit & hit);
+private:
+   int numFragments;
+};
+
+/*********************************************
+ * KILL HANDLER
+ * The bird dies and the bullet is spent
+ *********************************************/
+class KillHandler : public HitHandler
+{
+public:
+   void handle(Hit & hit);
+};
+
+/*********************************************
+ * BOMB DETONATION HANDLER
+ * A bomb that hits a bird goes off right there: a bigger blast,
+ * thrown all around the bomb instead of along its path, that takes
+ * the bird with it. Its shrapnel is thrown when the zombies are
+ * cleaned up
+ *********************************************/
+class BombDetonationHandler : public HitHandler
+{
+public:
+   BombDetonationHandler(int numFragments = 50) : numFragments(numFragments) {}
+   void handle(Hit & hit);
+private:
+   int numFragments;
+};
+
+/*********************************************
+ * HIT RATIO HANDLER
+ * Count the bird as hit
+ *********************************************/
+class HitRatioHandler : public HitHandler
+{
+public:
+   HitRatioHandler(HitRatio & hitRatio) : hitRatio(hitRatio) {}
+   void handle(Hit & hit);
+private:
+   HitRatio & hitRatio;
+};
+
+/*********************************************
+ * SCORING HANDLER
+ * The bird's points move onto the bullet to be awarded when
+ * the bullet is cleaned up
+ *********************************************/
+class ScoringHandler : public HitHandler
+{
+public:
+   void handle(Hit & hit);
+};
+
+/*********************************************
+ * HIT CHAIN
+ * The handlers in the order they were registered. Before compile() is
+ * called a hit walks the whole chain; after, it only visits the handlers
+ * registered for its (bird type, bullet type) pair.
+ *********************************************/
+class HitChain
+{
+public:
+   HitChain() : compiled(false) {}
+
+   // register a handler for one pair, or for every pair
+   void add(HitHandler * pHandler, BirdType bird, BulletType bullet);
+   void add(HitHandler * pHandler);
+
+   // build the dispatch table
+   void compile();
+
+   // pass a hit to the handlers
+   void handle(Hit & hit) const;
+
+   // pass a hit down every link, testing each one
+   void walk(Hit & hit) const;
+
+   bool isCompiled() const { return compiled; }
+
+private:
+   void link(HitHandler * pHandler, int bird, int bullet);
+
+   struct Link
+   {
+      HitHandler * pHandler;
+      int bird;                // the bird type, or -1 for all
+      int bullet;              // the bullet type, or -1 for all
+   };
+
+   std::vector<std::unique_ptr<HitHandler>> handlers;   // we own these
+   std::vector<Link> chain;                              // in order
+   std::vector<HitHandler *> table[NUM_BIRD_TYPES][NUM_BULLET_TYPES];
+   bool compiled;
+};
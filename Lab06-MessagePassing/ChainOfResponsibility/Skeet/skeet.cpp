@@ -31,6 +31,37 @@ using namespace std;
 #define GLUT_TEXT GLUT_BITMAP_HELVETICA_12
 #endif // _WIN32
 
+/************************
+ * SKEET BUILD HIT CHAIN
+ * Register the hit handlers in the order they should run, then
+ * compile the chain into its dispatch table
+ ************************/
+void Skeet::buildHitChain(HitChain & chain, HitRatio & hitRatio)
+{
+   // pellets and missiles make an explosion and are spent. Shrapnel is
+   // small, so its explosion is too. A bomb goes off on its own terms
+   EffectsHandler * pExplode = new EffectsHandler(25);
+   EffectsHandler * pPuff = new EffectsHandler(10);
+   KillHandler * pKill = new KillHandler;
+   BombDetonationHandler * pDetonate = new BombDetonationHandler(50);
+   for (int bird = 0; bird < NUM_BIRD_TYPES; bird++)
+   {
+      chain.add(pExplode,  (BirdType)bird, PELLET);
+      chain.add(pExplode,  (BirdType)bird, MISSILE);
+      chain.add(pPuff,     (BirdType)bird, SHRAPNEL);
+      chain.add(pKill,     (BirdType)bird, PELLET);
+      chain.add(pKill,     (BirdType)bird, MISSILE);
+      chain.add(pKill,     (BirdType)bird, SHRAPNEL);
+      chain.add(pDetonate, (BirdType)bird, BOMB);
+   }
+
+   // every hit counts the same towards the ratio and the score
+   chain.add(new HitRatioHandler(hitRatio));
+   chain.add(new ScoringHandler);
+
+   chain.compile();
+}
+
 /************************
  * SKEET ANIMATE
  * move the gameplay by one unit of time
@@ -74,14 +105,11 @@ void Skeet::animate()
              minimumDistance(element->getPosition(), element->getVelocity(),
                              bullet->getPosition(),  bullet->getVelocity()))
          {
-            for (int i = 0; i < 25; i++)
-               effects.push_back(new Fragment(bullet->getPosition(), bullet->getVelocity()));
-            element->kill();
-            bullet->kill();
-            hitRatio.adjust(1);
-            bullet->setValue(-(element->getPoints()));
-            element->setPoints(0);
+            Hit hit = { *element, *bullet, blasts };
+            hitChain.handle(hit);
          }
+   makeFragments(blasts, effects);
+   blasts.clear();
    
    // remove the zombie birds
    for (auto it = birds.begin(); it != birds.end();)
@@ -18,8 +18,10 @@
 #include "time.h"
 #include "score.h"
 #include "points.h"
+#include "hitHandler.h"
 
 #include <list>
+#include <vector>
 
 /*************************************************************************
  * Skeet
@@ -29,7 +31,10 @@ class Skeet
 {
 public:
     Skeet(Position & dimensions) : dimensions(dimensions),
-        gun(Position(800.0, 0.0)), time(), score(), hitRatio(), bullseye(false) {}
+        gun(Position(800.0, 0.0)), time(), score(), hitRatio(), bullseye(false)
+    {
+        buildHitChain(hitChain, hitRatio);
+    }
 
     // handle all user input
     void interact(const UserInput& ui);
@@ -43,6 +48,9 @@ public:
 
     // is the game currently playing right now?
     bool isPlaying() const { return time.isPlaying();  }
+
+    // register everything that happens when a bullet hits a bird
+    static void buildHitChain(HitChain & chain, HitRatio & hitRatio);
 private:
     // generate new birds
     void spawn();                  
@@ -56,10 +64,12 @@ private:
     std::list<Bird*> birds;        // all the shootable birds
     std::list<Bullet*> bullets;    // the bullets
     std::list<Effect*> effects;    // the fragments of a dead bird.
+    std::vector<Blast> blasts;     // fragments the hits of this frame asked for
     std::list<Points>  points;     // point values;
     Time time;                     // how many frames have transpired since the beginning
     Score score;                   // the player's score
     HitRatio hitRatio;             // the hit ratio for the birds
+    HitChain hitChain;             // what happens when a bird is hit
     Position dimensions;           // size of the screen
     bool bullseye;
 };
@@ -0,0 +1,71 @@
+/***********************************************************************
+ * Source File:
+ *    OBSERVER : Subjects that tell their observers when they change
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    A subject collects changes as they happen during a frame and tells
+ *    its observers once, with the combined change, at the end of the
+ *    frame or at the end of the level. Nothing is sent when nothing
+ *    changed.
+ ************************************************************************/
+
+#include "observer.h"
+#include <algorithm>
+#include <cassert>
+using namespace std;
+
+/*********************************************
+ * SUBJECT : ATTACH
+ * Subscribe an observer at the given granularity
+ *********************************************/
+void Subject::attach(Observer * pObserver, Granularity granularity)
+{
+   assert(pObserver);
+   vector<Observer *> & observers =
+      (granularity == PER_FRAME ? frameObservers : levelObservers);
+   if (find(observers.begin(), observers.end(), pObserver) == observers.end())
+      observers.push_back(pObserver);
+}
+
+/*********************************************
+ * SUBJECT : DETACH
+ * Unsubscribe an observer, whatever its granularity
+ *********************************************/
+void Subject::detach(Observer * pObserver)
+{
+   frameObservers.erase(remove(frameObservers.begin(), frameObservers.end(), pObserver),
+                        frameObservers.end());
+   levelObservers.erase(remove(levelObservers.begin(), levelObservers.end(), pObserver),
+                        levelObservers.end());
+}
+
+/*********************************************
+ * SUBJECT : END FRAME
+ * Send the frame's combined change to the per-frame observers
+ *********************************************/
+void Subject::endFrame()
+{
+   if (frameDelta == 0)
+      return;
+
+   for (auto pObserver : frameObservers)
+      pObserver->update(frameDelta);
+   levelDelta += frameDelta;
+   frameDelta = 0;
+}
+
+/*********************************************
+ * SUBJECT : END LEVEL
+ * Send the level's combined change to the per-level observers
+ *********************************************/
+void Subject::endLevel()
+{
+   endFrame();
+   if (levelDelta == 0)
+      return;
+
+   for (auto pObserver : levelObservers)
+      pObserver->update(levelDelta);
+   levelDelta = 0;
+}
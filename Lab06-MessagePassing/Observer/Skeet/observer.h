@@ -0,0 +1,63 @@
+/***********************************************************************
+ * Header File:
+ *    OBSERVER : Subjects that tell their observers when they change
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    A subject collects changes as they happen during a frame and tells
+ *    its observers once, with the combined change, at the end of the
+ *    frame or at the end of the level. Nothing is sent when nothing
+ *    changed.
+ ************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+/*********************************************
+ * GRANULARITY
+ * How often an observer wants to hear about changes
+ *********************************************/
+enum Granularity { PER_FRAME, PER_LEVEL };
+
+/*********************************************
+ * OBSERVER
+ * Something that wants to know when a subject changes
+ *********************************************/
+class Observer
+{
+public:
+   virtual ~Observer() {}
+   virtual void update(int delta) = 0;
+};
+
+/*********************************************
+ * SUBJECT
+ * Something that changes, accumulating the changes until
+ * it is time to tell the observers
+ *********************************************/
+class Subject
+{
+public:
+   Subject() : frameDelta(0), levelDelta(0) {}
+
+   // subscribe and unsubscribe
+   void attach(Observer * pObserver, Granularity granularity = PER_FRAME);
+   void detach(Observer * pObserver);
+
+   // something changed. Nobody is told yet
+   void accumulate(int delta) { frameDelta += delta; }
+
+   // tell the observers what changed during the frame or the level
+   void endFrame();
+   void endLevel();
+
+   // forget everything that has not been sent yet
+   void discard() { frameDelta = levelDelta = 0; }
+
+private:
+   std::vector<Observer *> frameObservers;   // told every frame
+   std::vector<Observer *> levelObservers;   // told every level
+   int frameDelta;                           // change this frame
+   int levelDelta;                           // change this level
+};
@@ -42,12 +42,13 @@ string HitRatio::getText() const
 
 /************************
  * HIT RATIO  ADJUST
- * Adjust the score for a bird hit (positive) or missed (negative)
+ * Adjust the score for birds hit (positive) or missed (negative).
+ * The magnitude is the number of birds.
  ************************/
 void HitRatio::adjust(int value)
 {
     if (value > 0)
-        numKilled++;
+        numKilled += value;
     else if (value < 0)
-        numMissed++;
+        numMissed -= value;
 }
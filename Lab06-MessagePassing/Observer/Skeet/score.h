@@ -9,18 +9,20 @@
 
 #pragma once
 #include <string>
+#include "observer.h"
 
 /**********************
  * STATUS
- * How well the player is doing
+ * How well the player is doing. Observes the subjects that change it.
  **********************/
-class Status
+class Status : public Observer
 {
 public:
     Status() {}
     virtual std::string getText() const = 0;
     virtual void adjust(int value) = 0;
     virtual void reset() = 0;
+    void update(int delta) { adjust(delta); }
 };
 
 /**********************
@@ -42,6 +42,11 @@ void Skeet::animate()
    // if status, then do not move the game
    if (time.isStatus())
    {
+      // the level is over: let the per-level observers know how it went
+      pointsEarned.endLevel();
+      birdsKilled.endLevel();
+      birdsMissed.endLevel();
+
       // get rid of the bullets and the birds without changing the score
       birds.clear();
       bullets.clear();
@@ -57,7 +62,8 @@ void Skeet::animate()
    for (auto element : birds)
    {
       element->advance();
-      hitRatio.adjust(element->isDead() ? -1 : 0);
+      if (element->isDead())
+         birdsMissed.accumulate(-1);
    }
    for (auto bullet : bullets)
       bullet->move(effects);
@@ -78,7 +84,7 @@ void Skeet::animate()
                effects.push_back(new Fragment(bullet->getPosition(), bullet->getVelocity()));
             element->kill();
             bullet->kill();
-            hitRatio.adjust(1);
+            birdsKilled.accumulate(1);
             bullet->setValue(-(element->getPoints()));
             element->setPoints(0);
          }
@@ -89,7 +95,7 @@ void Skeet::animate()
       {
          if ((*it)->getPoints())
             points.push_back(Points((*it)->getPosition(), (*it)->getPoints()));
-         score.adjust((*it)->getPoints());
+         pointsEarned.accumulate((*it)->getPoints());
          it = birds.erase(it);
       }
       else
@@ -102,7 +108,7 @@ void Skeet::animate()
          (*it)->death(bullets);
          int value = -(*it)->getValue();
          points.push_back(Points((*it)->getPosition(), value));
-         score.adjust(value);
+         pointsEarned.accumulate(value);
          it = bullets.erase(it);
       }
       else
@@ -121,6 +127,11 @@ void Skeet::animate()
          it = points.erase(it);
       else
          ++it;
+
+   // one notification per frame with everything that changed
+   pointsEarned.endFrame();
+   birdsKilled.endFrame();
+   birdsMissed.endFrame();
 }
 
 /************************************************************************
@@ -363,6 +374,9 @@ void Skeet::interact(const UserInput & ui)
       time.reset();
       score.reset();
       hitRatio.reset();
+      pointsEarned.discard();
+      birdsKilled.discard();
+      birdsMissed.discard();
       return;
    }
 
@@ -18,6 +18,7 @@
 #include "time.h"
 #include "score.h"
 #include "points.h"
+#include "observer.h"
 
 #include <list>
 
@@ -29,7 +30,12 @@ class Skeet
 {
 public:
     Skeet(Position & dimensions) : dimensions(dimensions),
-        gun(Position(800.0, 0.0)), time(), score(), hitRatio(), bullseye(false) {}
+        gun(Position(800.0, 0.0)), time(), score(), hitRatio(), bullseye(false)
+    {
+        pointsEarned.attach(&score);
+        birdsKilled.attach(&hitRatio);
+        birdsMissed.attach(&hitRatio);
+    }
 
     // handle all user input
     void interact(const UserInput& ui);
@@ -60,6 +66,9 @@ private:
     Time time;                     // how many frames have transpired since the beginning
     Score score;                   // the player's score
     HitRatio hitRatio;             // the hit ratio for the birds
+    Subject pointsEarned;          // points won or lost this frame
+    Subject birdsKilled;           // birds shot this frame (positive)
+    Subject birdsMissed;           // birds that got away (negative)
     Position dimensions;           // size of the screen
     bool bullseye;
 };
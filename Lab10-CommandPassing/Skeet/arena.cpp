@@ -0,0 +1,42 @@
+/***********************************************************************
+ * Source File:
+ *    ARENA : Memory that is all given back at once
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    The slow path of the bump-pointer allocator: finding or making a
+ *    block when the current one is full.
+ ************************************************************************/
+
+#include "arena.h"
+
+/*********************************************
+ * ARENA : NEXT BLOCK
+ * The first block after the current one with room for size bytes.
+ * One that was kept from before a reset is used again if it is big
+ * enough, otherwise a new one goes in its place in line.
+ *********************************************/
+void Arena::nextBlock(size_t size)
+{
+   if (current < blocks.size())
+      current++;
+   offset = 0;
+   if (current < blocks.size() && blocks[current].size >= size)
+      return;
+
+   size_t newSize = size > blockSize ? size : blockSize;
+   Block block = { std::unique_ptr<char[]>(new char[newSize]), newSize };
+   blocks.insert(blocks.begin() + current, std::move(block));
+}
+
+/*********************************************
+ * ARENA : GET RESERVED
+ * Every byte of every block
+ *********************************************/
+size_t Arena::getReserved() const
+{
+   size_t reserved = 0;
+   for (auto & block : blocks)
+      reserved += block.size;
+   return reserved;
+}
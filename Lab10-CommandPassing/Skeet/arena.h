@@ -0,0 +1,95 @@
+/***********************************************************************
+ * Header File:
+ *    ARENA : Memory that is all given back at once
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    A bump-pointer allocator. Each allocation takes the next bytes of
+ *    the current block, and nothing is given back until reset(), which
+ *    rewinds to the first block in constant time. The blocks are kept,
+ *    so the next level makes its effects in memory already in the cache.
+ *    Destructors are never run: only things that own nothing else, like
+ *    the effects, belong in an arena. Nor does a container's own storage:
+ *    some standard libraries allocate a list's sentinel node when the
+ *    list is made, and a reset() would hand it out again while the list
+ *    still uses it. An arena is used by one thread at a time.
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/*********************************************
+ * ARENA
+ * Bump-pointer allocation, freed all at once
+ *********************************************/
+class Arena
+{
+public:
+   // every allocation is aligned this well
+   static const size_t ALIGN = alignof(std::max_align_t);
+
+   Arena(size_t blockSize = 64 * 1024) :
+      blockSize(blockSize), current(0), offset(0), used(0), peak(0) {}
+   Arena(Arena &&) = default;
+   Arena & operator = (Arena &&) = default;
+
+   // what an allocation of size bytes really takes
+   static size_t footprint(size_t size) { return (size + ALIGN - 1) / ALIGN * ALIGN; }
+
+   // the next size bytes
+   void * allocate(size_t size)
+   {
+      size = footprint(size);
+      if (current == blocks.size() || offset + size > blocks[current].size)
+         nextBlock(size);
+      void * p = blocks[current].data.get() + offset;
+      offset += size;
+      used += size;
+      return p;
+   }
+
+   // make a new T in the arena
+   template <class T, class ... Args>
+   T * make(Args && ... args)
+   {
+      static_assert(alignof(T) <= ALIGN, "too strictly aligned for an arena");
+      return new (allocate(sizeof(T))) T(std::forward<Args>(args) ...);
+   }
+
+   // forget everything that was allocated, keeping the blocks
+   void reset()
+   {
+      peak = getPeak();
+      current = 0;
+      offset = 0;
+      used = 0;
+   }
+
+   // bytes handed out since the last reset, the most there ever were,
+   // and what the blocks hold in all
+   size_t getUsed()     const { return used; }
+   size_t getPeak()     const { return used > peak ? used : peak; }
+   size_t getReserved() const;
+
+private:
+   // move on to a block with room for size bytes
+   void nextBlock(size_t size);
+
+   struct Block
+   {
+      std::unique_ptr<char[]> data;
+      size_t size;
+   };
+
+   std::vector<Block> blocks;
+   size_t blockSize;    // how big a new block is, unless one allocation is bigger
+   size_t current;      // the block being handed out
+   size_t offset;       // ... and how much of it is gone
+   size_t used;         // bytes handed out since the last reset
+   size_t peak;         // the most used ever was at a reset
+};
@@ -0,0 +1,285 @@
+/***********************************************************************
+ * Source File:
+ *    AUTOPILOT : Something to play Skeet when nobody is at the keyboard
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Each frame the autopilot looks at the birds, works out where a
+ *    shot fired now would meet each one, turns the gun toward the
+ *    easiest of those points, and fires when it is lined up. It issues
+ *    the same commands the keyboard does, so it makes a steady and
+ *    repeatable load for benchmarks. Every live bird is solved every
+ *    frame, four at a time, and the time that takes is kept so the
+ *    autopilot's own cost can be taken out of any measurement.
+ ************************************************************************/
+
+#include "autopilot.h"
+#include <chrono>
+#include <cmath>
+#include <type_traits>
+using namespace std;
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define AUTOPILOT_SSE
+#endif // SSE
+
+#ifndef M_PI_2
+#define M_PI_2 1.57079632679489661923
+#endif
+
+// where shots come from (see Bullet); how fast they go is in the tuning
+const float MUZZLE_X       = 799.0f;
+const float MUZZLE_Y       = 1.0f;
+
+// birds solved together, and how far ahead we look for each
+const size_t LANES   = 4;
+const int    HORIZON = 120;
+
+// how close is close enough to shoot, and how often
+const double AIM_TOLERANCE  = 0.02;
+const int    FRAMES_BETWEEN_SHOTS    = 3;
+const int    FRAMES_BETWEEN_MISSILES = 45;
+const int    FRAMES_BETWEEN_BOMBS    = 90;
+
+/*********************************************
+ * AUTOPILOT : GATHER
+ * Every live bird into a lane. Spare lanes in the last batch are
+ * parked far off the screen where no shot can reach them.
+ *********************************************/
+void Autopilot::gather(const Skeet & skeet)
+{
+   numBirds = 0;
+   skeet.getBirds().forEach([&](const auto & element)
+   {
+      if (element.isDead())
+         return;
+      if (x.size() <= numBirds)
+      {
+         size_t size = numBirds + LANES;
+         for (auto * pLane : { &x, &y, &dx, &dy, &drag, &lift, &buoyancy, &aimX, &aimY })
+            pLane->resize(size);
+         isReachable.resize(size);
+      }
+
+      Position pt = element.getPosition();
+      Velocity v = element.getVelocity();
+      // a crazy bird's turns are random, so the best guess is straight on
+      Flight flight = std::decay_t<decltype(element)>::flight(skeet.getTuning());
+      x[numBirds]        = (float)pt.getX();
+      y[numBirds]        = (float)pt.getY();
+      dx[numBirds]       = (float)v.getDx();
+      dy[numBirds]       = (float)v.getDy();
+      drag[numBirds]     = (float)flight.drag;
+      lift[numBirds]     = (float)flight.lift;
+      buoyancy[numBirds] = (float)flight.buoyancy;
+      numBirds++;
+   });
+
+   for (size_t lane = numBirds; lane % LANES; lane++)
+   {
+      x[lane] = y[lane] = -1.0e6f;
+      dx[lane] = dy[lane] = lift[lane] = buoyancy[lane] = 0.0f;
+      drag[lane] = 1.0f;
+   }
+}
+
+/*********************************************
+ * AUTOPILOT : SOLVE
+ * For each bird, the first frame at which a shot fired now could be
+ * where the bird is, found by flying the bird forward exactly as its
+ * fly() would: drag, lift, move, buoyancy. That frame's position is
+ * where to aim. Four birds go through each step together.
+ *********************************************/
+void Autopilot::solve(float speed)
+{
+   size_t end = (numBirds + LANES - 1) / LANES * LANES;
+
+#ifdef AUTOPILOT_SSE
+   const __m128 muzzleX = _mm_set1_ps(MUZZLE_X);
+   const __m128 muzzleY = _mm_set1_ps(MUZZLE_Y);
+   for (size_t lane = 0; lane < end; lane += LANES)
+   {
+      __m128 px = _mm_loadu_ps(&x[lane]);
+      __m128 py = _mm_loadu_ps(&y[lane]);
+      __m128 vx = _mm_loadu_ps(&dx[lane]);
+      __m128 vy = _mm_loadu_ps(&dy[lane]);
+      __m128 d  = _mm_loadu_ps(&drag[lane]);
+      __m128 up = _mm_loadu_ps(&lift[lane]);
+      __m128 fl = _mm_loadu_ps(&buoyancy[lane]);
+      __m128 ax = _mm_setzero_ps();
+      __m128 ay = _mm_setzero_ps();
+      __m128 found = _mm_setzero_ps();
+
+      for (int frame = 1; frame <= HORIZON && _mm_movemask_ps(found) != 0xf; frame++)
+      {
+         vx = _mm_mul_ps(vx, d);
+         vy = _mm_add_ps(_mm_mul_ps(vy, d), up);
+         px = _mm_add_ps(px, vx);
+         py = _mm_add_ps(py, vy);
+         vy = _mm_add_ps(vy, fl);
+
+         __m128 ex = _mm_sub_ps(px, muzzleX);
+         __m128 ey = _mm_sub_ps(py, muzzleY);
+         __m128 distance = _mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey));
+         float reach = speed * frame;
+         __m128 hit = _mm_andnot_ps(found, _mm_cmple_ps(distance, _mm_set1_ps(reach * reach)));
+
+         ax = _mm_or_ps(_mm_and_ps(hit, px), _mm_andnot_ps(hit, ax));
+         ay = _mm_or_ps(_mm_and_ps(hit, py), _mm_andnot_ps(hit, ay));
+         found = _mm_or_ps(found, hit);
+      }
+
+      _mm_storeu_ps(&aimX[lane], ax);
+      _mm_storeu_ps(&aimY[lane], ay);
+      int mask = _mm_movemask_ps(found);
+      for (size_t i = 0; i < LANES; i++)
+         isReachable[lane + i] = (mask >> i) & 1;
+   }
+#else // !AUTOPILOT_SSE
+   // the same steps, a batch at a time, for the compiler to vectorize
+   for (size_t lane = 0; lane < end; lane += LANES)
+   {
+      float px[LANES], py[LANES], vx[LANES], vy[LANES];
+      float ax[LANES] = {}, ay[LANES] = {};
+      int found[LANES] = {};
+      for (size_t i = 0; i < LANES; i++)
+      {
+         px[i] = x[lane + i];
+         py[i] = y[lane + i];
+         vx[i] = dx[lane + i];
+         vy[i] = dy[lane + i];
+      }
+
+      int numFound = 0;
+      for (int frame = 1; frame <= HORIZON && numFound < (int)LANES; frame++)
+      {
+         float reach = speed * frame;
+         numFound = 0;
+         for (size_t i = 0; i < LANES; i++)
+         {
+            vx[i] = vx[i] * drag[lane + i];
+            vy[i] = vy[i] * drag[lane + i] + lift[lane + i];
+            px[i] += vx[i];
+            py[i] += vy[i];
+            vy[i] += buoyancy[lane + i];
+
+            float ex = px[i] - MUZZLE_X;
+            float ey = py[i] - MUZZLE_Y;
+            int hit = !found[i] & (ex * ex + ey * ey <= reach * reach);
+            ax[i] = hit ? px[i] : ax[i];
+            ay[i] = hit ? py[i] : ay[i];
+            found[i] |= hit;
+            numFound += found[i];
+         }
+      }
+
+      for (size_t i = 0; i < LANES; i++)
+      {
+         aimX[lane + i] = ax[i];
+         aimY[lane + i] = ay[i];
+         isReachable[lane + i] = found[i];
+      }
+   }
+#endif // !AUTOPILOT_SSE
+}
+
+/*********************************************
+ * AUTOPILOT : CHOOSE
+ * Of the birds that can be hit on the screen, the one needing the
+ * least turning. Returns false if there is none.
+ *********************************************/
+bool Autopilot::choose(double gun, double & angle) const
+{
+   bool isTarget = false;
+   for (size_t lane = 0; lane < numBirds; lane++)
+   {
+      if (!isReachable[lane] ||
+          aimX[lane] < 0.0f || aimX[lane] > MUZZLE_X ||
+          aimY[lane] < 0.0f || aimY[lane] > 800.0f)
+         continue;
+
+      double candidate = atan2(aimY[lane] - MUZZLE_Y, MUZZLE_X - aimX[lane]);
+      if (candidate < 0.0 || candidate > M_PI_2)
+         continue;
+      if (!isTarget || fabs(candidate - gun) < fabs(angle - gun))
+      {
+         angle = candidate;
+         isTarget = true;
+      }
+   }
+   return isTarget;
+}
+
+/*********************************************
+ * AUTOPILOT : DECIDE
+ * Turn toward the bird that needs the least turning, fire when lined
+ * up. Missiles and bombs go out now and then once the level allows;
+ * while one is due the aim is for its slower speed.
+ *********************************************/
+void Autopilot::decide(const Skeet & skeet, vector<Command> & commands)
+{
+   commands.clear();
+   if (cooldown > 0)
+      cooldown--;
+   if (missileCooldown > 0)
+      missileCooldown--;
+   if (bombCooldown > 0)
+      bombCooldown--;
+
+   // nothing to shoot at between levels, and a shot would restart a finished game
+   if (!skeet.isPlaying() || skeet.isGameOver())
+      return;
+
+   // which weapon is next; see Skeet::execute() for when each is allowed
+   Command fire = { skeet.getFrame(), FIRE_PELLET, 0, 0 };
+   const Tuning & tuning = skeet.getTuning();
+   float speed = (float)tuning.pelletSpeed;
+   if (skeet.getLevel() > 2 && bombCooldown == 0)
+   {
+      fire.type = FIRE_BOMB;
+      speed = (float)tuning.bombSpeed;
+   }
+   else if (skeet.getLevel() > 1 && missileCooldown == 0)
+   {
+      fire.type = FIRE_MISSILE;
+      speed = (float)tuning.missileSpeed;
+   }
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   gather(skeet);
+   solve(speed);
+   secondsSolving += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+   numSolves += numBirds;
+
+   double gun = skeet.getGunAngle();
+   double best = 0.0;
+   if (!choose(gun, best))
+      return;
+
+   // turn: a held key turns faster, so "hold" it when far off
+   unsigned int frame = skeet.getFrame();
+   double difference = best - gun;
+   unsigned char amount = fabs(difference) > 0.06 ? 11 : 1;
+   if (difference > AIM_TOLERANCE / 2.0)
+   {
+      commands.push_back({ frame, ROTATE_GUN, amount, 0 });
+      commands.push_back({ frame, STEER_MISSILE, 1, 0 });
+   }
+   else if (difference < -AIM_TOLERANCE / 2.0)
+   {
+      commands.push_back({ frame, ROTATE_GUN, 0, amount });
+      commands.push_back({ frame, STEER_MISSILE, 0, 1 });
+   }
+
+   // fire when lined up
+   if (fabs(difference) < AIM_TOLERANCE && cooldown == 0)
+   {
+      commands.push_back(fire);
+      cooldown = FRAMES_BETWEEN_SHOTS;
+      if (fire.type == FIRE_MISSILE)
+         missileCooldown = FRAMES_BETWEEN_MISSILES;
+      else if (fire.type == FIRE_BOMB)
+         bombCooldown = FRAMES_BETWEEN_BOMBS;
+   }
+}
@@ -0,0 +1,63 @@
+/***********************************************************************
+ * Header File:
+ *    AUTOPILOT : Something to play Skeet when nobody is at the keyboard
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Each frame the autopilot looks at the birds, works out where a
+ *    shot fired now would meet each one, turns the gun toward the
+ *    easiest of those points, and fires when it is lined up. It issues
+ *    the same commands the keyboard does, so it makes a steady and
+ *    repeatable load for benchmarks. Every live bird is solved every
+ *    frame, four at a time, and the time that takes is kept so the
+ *    autopilot's own cost can be taken out of any measurement.
+ ************************************************************************/
+
+#pragma once
+
+#include "skeet.h"
+#include "command.h"
+#include <vector>
+
+/*********************************************
+ * AUTOPILOT
+ * A steady, unexciting player
+ *********************************************/
+class Autopilot
+{
+public:
+   Autopilot() : cooldown(0), missileCooldown(0), bombCooldown(0),
+                 numBirds(0), numSolves(0), secondsSolving(0.0) {}
+
+   // the commands for this frame, in place of the keyboard's
+   void decide(const Skeet & skeet, std::vector<Command> & commands);
+
+   // how much aiming has been done, and how long it took
+   unsigned long long getSolves() const { return numSolves;      }
+   double getSecondsSolving()     const { return secondsSolving; }
+   double getSolvesPerSecond()    const
+   {
+      return secondsSolving > 0.0 ? numSolves / secondsSolving : 0.0;
+   }
+
+private:
+   void gather(const Skeet & skeet);        // live birds into the lanes
+   void solve(float speed);                 // where each can be hit
+   bool choose(double gun, double & angle) const;
+
+   int cooldown;               // frames until we may fire a pellet again
+   int missileCooldown;        // ... a missile
+   int bombCooldown;           // ... a bomb
+
+   // one lane per live bird, padded out to a whole batch
+   size_t numBirds;
+   std::vector<float> x, y, dx, dy;         // where each is, how it moves
+   std::vector<float> drag;                 // speed kept each frame
+   std::vector<float> lift;                 // added to dy before moving
+   std::vector<float> buoyancy;             // added to dy after moving
+   std::vector<float> aimX, aimY;           // where the shot meets it
+   std::vector<int>   isReachable;          // can the shot meet it at all?
+
+   unsigned long long numSolves;            // birds solved, all frames
+   double secondsSolving;
+};
@@ -9,6 +9,11 @@
 
 #include <cassert>
 #include "bird.h"
+#include "dice.h"
+
+#ifdef NO_GRAPHICS
+#include "noGraphics.h"  // draw nothing: no OpenGL, no GLUT
+#else // !NO_GRAPHICS
 
 #ifdef __APPLE__
 #define GL_SILENCE_DEPRECATION
@@ -31,6 +36,7 @@
 #include <math.h>
 #define GLUT_TEXT GLUT_BITMAP_HELVETICA_12
 #endif // _WIN32
+#endif // NO_GRAPHICS
 
 
 /***************************************************************/
@@ -47,14 +53,14 @@
 int randomInt(int min, int max)
 {
    assert(min < max);
-   int num = (rand() % (max - min)) + min;
+   int num = (roll() % (max - min)) + min;
    assert(min <= num && num <= max);
    return num;
 }
 double randomFloat(double min, double max)
 {
    assert(min <= max);
-   double num = min + ((double)rand() / (double)RAND_MAX * (max - min));
+   double num = min + ((double)roll() / (double)RAND_MAX * (max - min));
    assert(min <= num && num <= max);
    return num;
 }
@@ -68,7 +74,7 @@ double randomFloat(double min, double max)
 /******************************************************************
  * STANDARD constructor
  ******************************************************************/
-Standard::Standard(double radius, double speed, int points) : Bird()
+Standard::Standard(double radius, double speed, int points)
 {
    // set the position: standard birds start from the middle
    pt.setY(randomFloat(dimensions.getY() * 0.25, dimensions.getY() * 0.75));
@@ -88,7 +94,7 @@ Standard::Standard(double radius, double speed, int points) : Bird()
 /******************************************************************
  * FLOATER constructor
  ******************************************************************/
-Floater::Floater(double radius, double speed, int points) : Bird()
+Floater::Floater(double radius, double speed, int points)
 {
    // floaters start on the lower part of the screen because they go up with time
    pt.setY(randomFloat(dimensions.getY() * 0.01, dimensions.getY() * 0.5));
@@ -108,7 +114,7 @@ Floater::Floater(double radius, double speed, int points) : Bird()
 /******************************************************************
  * SINKER constructor
  ******************************************************************/
-Sinker::Sinker(double radius, double speed, int points) : Bird()
+Sinker::Sinker(double radius, double speed, int points)
 {
    // sinkers start on the upper part of the screen because they go down with time
    pt.setY(randomFloat(dimensions.getY() * 0.50, dimensions.getY() * 0.95));
@@ -128,7 +134,7 @@ Sinker::Sinker(double radius, double speed, int points) : Bird()
 /******************************************************************
  * CRAZY constructor
  ******************************************************************/
-Crazy::Crazy(double radius, double speed, int points) : Bird()
+Crazy::Crazy(double radius, double speed, int points)
 {
    // crazy birds start in the middle and can go any which way
    pt.setY(randomFloat(dimensions.getY() * 0.25, dimensions.getY() * 0.75));
@@ -145,99 +151,6 @@ Crazy::Crazy(double radius, double speed, int points) : Bird()
    this->radius = radius;
 }
 
- /***************************************************************/
- /***************************************************************/
- /*                            ADVANCE                          */
- /***************************************************************/
- /***************************************************************/
-
-/*********************************************
- * STANDARD ADVANCE
- * How the standard bird moves - inertia and drag
- *********************************************/
-void Standard::advance()
-{
-   // small amount of drag
-   v *= 0.995;
-
-   // inertia
-   pt.add(v);
-
-   // out of bounds checker
-   if (isOutOfBounds())
-   {
-      kill();
-      points *= -1; // points go negative when it is missed!
-   }
-}
-
-/*********************************************
- * FLOATER ADVANCE
- * How the floating bird moves: strong drag and anti-gravity
- *********************************************/
-void Floater::advance()
-{
-   // large amount of drag
-   v *= 0.990;
-
-   // inertia
-   pt.add(v);
-
-   // anti-gravity
-   v.addDy(0.05);
-
-   // out of bounds checker
-   if (isOutOfBounds())
-   {
-      kill();
-      points *= -1; // points go negative when it is missed!
-   }
-}
-
-/*********************************************
- * CRAZY ADVANCE
- * How the crazy bird moves, every half a second it changes direciton
- *********************************************/
-void Crazy::advance()
-{
-   // erratic turns eery half a second or so
-   if (randomInt(0, 15) == 0)
-   {
-      v.addDy(randomFloat(-1.5, 1.5));
-      v.addDx(randomFloat(-1.5, 1.5));
-   }
-
-   // inertia
-   pt.add(v);
-
-   // out of bounds checker
-   if (isOutOfBounds())
-   {
-      kill();
-      points *= -1; // points go negative when it is missed!
-   }
-}
-
-/*********************************************
- * SINKER ADVANCE
- * How the sinker bird moves, no drag but gravity
- *********************************************/
-void Sinker::advance()
-{
-   // gravity
-   v.addDy(-0.07);
-
-   // inertia
-   pt.add(v);
-
-   // out of bounds checker
-   if (isOutOfBounds())
-   {
-      kill();
-      points *= -1; // points go negative when it is missed!
-   }
-}
-
 /***************************************************************/
 /***************************************************************/
 /*                             DRAW                            */
@@ -284,10 +197,10 @@ void drawDisk(const Position& center, double radius,
 }
 
 /*********************************************
- * STANDARD DRAW
+ * STANDARD PAINT
  * Draw a standard bird: blue center and white outline
  *********************************************/
-void Standard::draw()
+void Standard::paint() const
 {
    if (!isDead())
    {
@@ -297,10 +210,10 @@ void Standard::draw()
 }
 
 /*********************************************
- * FLOATER DRAW
+ * FLOATER PAINT
  * Draw a floating bird: white center and blue outline
  *********************************************/
-void Floater::draw()
+void Floater::paint() const
 {
    if (!isDead())
    {
@@ -310,10 +223,10 @@ void Floater::draw()
 }
 
 /*********************************************
- * CRAZY DRAW
+ * CRAZY PAINT
  * Draw a crazy bird: concentric circles in a course gradient
  *********************************************/
-void Crazy::draw()
+void Crazy::paint() const
 {
    if (!isDead())
    {
@@ -326,10 +239,10 @@ void Crazy::draw()
 }
 
 /*********************************************
- * SINKER DRAW
+ * SINKER PAINT
  * Draw a sinker bird: black center and dark blue outline
  *********************************************/
-void Sinker::draw()
+void Sinker::paint() const
 {
    if (!isDead())
    {
@@ -9,6 +9,10 @@
 
 #pragma once
 #include "position.h"
+#include "trajectory.h"
+#include "dice.h"
+#include "handle.h"
+#include "tuning.h"
 
 /**********************
  * BIRD
@@ -20,18 +24,23 @@ protected:
    static Position dimensions; // size of the screen
    Position pt;                  // position of the flyer
    Velocity v;                // velocity of the flyer
-   double radius;             // the size (radius) of the flyer
+   Real radius;               // the size (radius) of the flyer
    bool dead;                 // is this flyer dead?
    int points;                // how many points is this worth?
+   Handle handle;             // to find it again, wherever it moves
+   unsigned int exitFrame;    // when it should leave the screen, 0 if never
    
 public:
-   Bird() : dead(false), points(0), radius(1.0) { }
+   Bird() : dead(false), points(0), radius(1.0), handle(NO_HANDLE), exitFrame(0) { }
+   virtual ~Bird() { }
    
    // setters
    void operator=(const Position    & rhs) { pt = rhs;    }
    void operator=(const Velocity & rhs) { v = rhs;     }
    void kill()                          { dead = true; }
    void setPoints(int pts)              { points = pts;}
+   void setHandle(const Handle & h)     { handle = h;  }
+   void setExitFrame(unsigned int f)    { exitFrame = f; }
 
    // getters
    bool isDead()           const { return dead;   }
@@ -39,61 +48,134 @@ public:
    Velocity getVelocity()  const { return v;      }
    double getRadius()      const { return radius; }
    int getPoints() const { return points; }
+   const Handle & getHandle()  const { return handle;    }
+   unsigned int getExitFrame() const { return exitFrame; }
    bool isOutOfBounds() const
    {
       return (pt.getX() < -radius || pt.getX() >= dimensions.getX() + radius ||
               pt.getY() < -radius || pt.getY() >= dimensions.getY() + radius);
    }
 
+   // out of bounds checker. Nobody checks every frame: the game works
+   // out when each bird should leave (see trajectory.h) and calls this then
+   void escape()
+   {
+      if (isOutOfBounds())
+      {
+         kill();
+         points *= -1; // points go negative when it is missed!
+      }
+   }
+
    // special functions
    virtual void draw() = 0;
-   virtual void advance() = 0;
+   virtual void advance(const Tuning & tuning) = 0;
+};
+
+// random numbers, used by the birds
+int    randomInt  (int    min, int    max);
+double randomFloat(double min, double max);
+
+/*********************************************
+ * BIRD KIND
+ * The base of each concrete bird. Each kind provides fly() and paint()
+ * as ordinary member functions, so a loop over birds of one kind calls
+ * them directly. advance() and draw() forward to them for code that only
+ * has a Bird.
+ *********************************************/
+template <class T>
+class BirdKind : public Bird
+{
+public:
+   void advance(const Tuning & tuning) { static_cast<T *>(this)->fly(tuning); }
+   void draw()    { static_cast<T *>(this)->paint(); }
+
+protected:
+   // inertia
+   void coast() { pt.add(v); }
 };
 
 /*********************************************
  * STANDARD
  * A standard bird: slows down, flies in a straight line
  *********************************************/
-class Standard : public Bird
+class Standard : public BirdKind<Standard>
 {
 public:
     Standard(double radius = 25.0, double speed = 5.0, int points = 10);
-    void draw();
-    void advance();
+    void paint() const;
+    void fly(const Tuning & tuning)
+    {
+       v *= tuning.standardDrag;
+       coast();
+    }
+
+    static Flight flight(const Tuning & tuning) { return { tuning.standardDrag, 0.0, 0.0 }; }
 };
 
 /*********************************************
  * FLOATER
  * A bird that floats like a balloon: flies up and really slows down
  *********************************************/
-class Floater : public Bird
+class Floater : public BirdKind<Floater>
 {
 public:
     Floater(double radius = 30.0, double speed = 5.0, int points = 15);
-    void draw();
-    void advance();
+    void paint() const;
+    void fly(const Tuning & tuning)
+    {
+       v *= tuning.floaterDrag;
+       coast();
+       v.addDy(tuning.floaterBuoyancy);
+    }
+
+    static Flight flight(const Tuning & tuning)
+    {
+       return { tuning.floaterDrag, 0.0, tuning.floaterBuoyancy };
+    }
 };
 
 /*********************************************
  * CRAZY
  * A crazy flying object: randomly changes direction
  *********************************************/
-class Crazy : public Bird
+class Crazy : public BirdKind<Crazy>
 {
 public:
     Crazy(double radius = 30.0, double speed = 4.5, int points = 30);
-    void draw();
-    void advance();
+    void paint() const;
+    void fly(const Tuning &)
+    {
+       // erratic turns eery half a second or so
+       if (turns.happens(15))
+       {
+          v.addDy(randomFloat(-1.5, 1.5));
+          v.addDx(randomFloat(-1.5, 1.5));
+       }
+       coast();
+    }
+
+    // straight, until the next turn
+    static Flight flight(const Tuning &) { return { 1.0, 0.0, 0.0 }; }
+
+private:
+    Chance turns;    // rolls only when it turns
 };
 
 /*********************************************
  * SINKER
  * A sinker bird: honors gravity
  *********************************************/
-class Sinker : public Bird
+class Sinker : public BirdKind<Sinker>
 {
 public:
     Sinker(double radius = 30.0, double speed = 4.5, int points = 20);
-    void draw();
-    void advance();
+    void paint() const;
+    void fly(const Tuning & tuning)
+    {
+       v.addDy(-tuning.sinkerGravity);
+       coast();
+    }
+
+    static Flight flight(const Tuning & tuning) { return { 1.0, -tuning.sinkerGravity, 0.0 }; }
 };
@@ -8,6 +8,11 @@
  ************************************************************************/
 
 #include "bullet.h"
+#include "dice.h"
+
+#ifdef NO_GRAPHICS
+#include "noGraphics.h"  // draw nothing: no OpenGL, no GLUT
+#else // !NO_GRAPHICS
 
 #ifdef __APPLE__
 #define GL_SILENCE_DEPRECATION
@@ -30,12 +35,16 @@
 #include <math.h>
 #define GLUT_TEXT GLUT_BITMAP_HELVETICA_12
 #endif // _WIN32
+#endif // NO_GRAPHICS
+
+const Rotation Missile::STEER_UP(0.04);
+const Rotation Missile::STEER_DOWN(-0.04);
 
 /*********************************************
  * BULLET constructor
  *********************************************/
 Bullet::Bullet(double angle, double speed, double radius, int value) :
-   dead(false), radius(radius), value(value)
+   dead(false), radius(radius), value(value), handle(NO_HANDLE), exitFrame(0)
 {
    // set the initial position
    pt.setX(dimensions.getX() - 1.0);
@@ -50,79 +59,26 @@ Bullet::Bullet(double angle, double speed, double radius, int value) :
 }
 
 /*********************************************
- * BOMB DEATH
+ * BOMB BURST
  * Bombs have a tendency to explode!
  *********************************************/
-void Bomb::death(std::list<Bullet*>& bullets)
+void Bomb::burst(std::vector<Shrapnel> & shrapnel, const Tuning & tuning) const
 {
-   for (int i = 0; i < 20; i++)
-      bullets.push_back(new Shrapnel(*this));
+   for (int i = 0; i < tuning.shrapnelPerBomb; i++)
+      shrapnel.push_back(Shrapnel(*this, tuning));
 }
 
- /***************************************************************/
- /***************************************************************/
- /*                             MOVE                            */
- /***************************************************************/
- /***************************************************************/
-
 /*********************************************
- * BULLET MOVE
- * Move the bullet along by one time period
- *********************************************/
-void Bullet::move(std::list<Effect*> & effects)
-{
-   // inertia
-   pt.add(v);
-
-   // out of bounds checker
-   if (isOutOfBounds())
-      kill();
-}
-
-/*********************************************
- * BOMB MOVE
- * Move the bomb along by one time period
- *********************************************/
-void Bomb::move(std::list<Effect*> & effects)
-{
-    // kill if it has been around too long
-    timeToDie--;
-    if (!timeToDie)
-        kill();
-
-    // do the inertia thing
-    Bullet::move(effects);
-}
-
-/*********************************************
- * MISSILE MOVE
- * Move the missile along by one time period
- *********************************************/
-void Missile::move(std::list<Effect*> & effects)
-{
-    // kill if it has been around too long
-   effects.push_back(new Exhaust(pt, v));
-
-    // do the inertia thing
-    Bullet::move(effects);
-}
-
-/*********************************************
- * SHRAPNEL MOVE
- * Move the shrapnel along by one time period
+ * BOMB DEATH
+ * The same explosion, for code that only has a list of bullets,
+ * with the numbers the game ships with
  *********************************************/
-void Shrapnel::move(std::list<Effect*> & effects)
+void Bomb::death(std::list<Bullet*>& bullets)
 {
-    // kill if it has been around too long
-    timeToDie--;
-    if (!timeToDie)
-        kill();
-
-    // add a streek
-    effects.push_back(new Streek(pt, v));
-    
-    // do the usual bullet stuff (like inertia)
-    Bullet::move(effects);
+   std::vector<Shrapnel> shrapnel;
+   burst(shrapnel, TUNING);
+   for (auto & piece : shrapnel)
+      bullets.push_back(new Shrapnel(piece));
 }
 
 /***************************************************************/
@@ -184,20 +140,20 @@ void Bullet::drawDot(const Position& point, double radius,
 }
 
 /*********************************************
- * PELLET OUTPUT
+ * PELLET PAINT
  * Draw a pellet - just a 3-pixel dot
  *********************************************/
-void Pellet::output()
+void Pellet::paint() const
 {
    if (!isDead())
       drawDot(pt, 3.0, 1.0, 1.0, 0.0);
 }
 
 /*********************************************
- * BOMB OUTPUT
+ * BOMB PAINT
  * Draw a bomb - many dots to make it have a soft edge
  *********************************************/
-void Bomb::output()
+void Bomb::paint() const
 {
    if (!isDead())
    {
@@ -210,23 +166,28 @@ void Bomb::output()
 }
 
 /*********************************************
- * SHRAPNEL OUTPUT
- * Draw a fragment - a bright yellow dot
+ * SHRAPNEL PAINT
+ * Draw a fragment - a bright yellow dot and its streek
  *********************************************/
-void Shrapnel::output()
+void Shrapnel::paint() const
 {
     if (!isDead())
+    {
+       streek.render(STREEK_FADE);
        drawDot(pt, radius, 1.0, 1.0, 0.0);
+    }
 }
 
 /*********************************************
- * MISSILE OUTPUT
- * Draw a missile - a line and a dot for the fins
+ * MISSILE PAINT
+ * Draw a missile - its exhaust, a line, and a dot for the fins
  *********************************************/
-void Missile::output()
+void Missile::paint() const
 {
     if (!isDead())
     {
+        exhaust.render(EXHAUST_FADE);
+
         // missile is a line with a dot at the end so it looks like fins.
         Position ptNext(pt);
         ptNext.add(v);
@@ -248,14 +209,14 @@ void Missile::output()
 int Bullet::random(int min, int max)
 {
    assert(min < max);
-   int num = (rand() % (max - min)) + min;
+   int num = (roll() % (max - min)) + min;
    assert(min <= num && num <= max);
    return num;
 }
 double Bullet::random(double min, double max)
 {
    assert(min <= max);
-   double num = min + ((double)rand() / (double)RAND_MAX * (max - min));
+   double num = min + ((double)roll() / (double)RAND_MAX * (max - min));
    assert(min <= num && num <= max);
    return num;
 }
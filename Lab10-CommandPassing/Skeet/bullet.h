@@ -10,7 +10,11 @@
 #pragma once
 #include "position.h"
 #include "effect.h"
+#include "trajectory.h"
+#include "handle.h"
+#include "tuning.h"
 #include <list>
+#include <vector>
 #include <cassert>
 
 /*********************************************
@@ -23,16 +27,21 @@ protected:
    static Position dimensions;   // size of the screen
    Position pt;                  // position of the bullet
    Velocity v;                // velocity of the bullet
-   double radius;             // the size (radius) of the bullet
+   Real radius;               // the size (radius) of the bullet
    bool dead;                 // is this bullet dead?
    int value;                 // how many points does this cost?
+   Handle handle;             // to find it again, wherever it moves
+   unsigned int exitFrame;    // when it should leave the screen, 0 if never
     
 public:
    Bullet(double angle = 0.0, double speed = 30.0, double radius = 5.0, int value = 1);
+   virtual ~Bullet() {}
    
    // setters
    void kill()                   { dead = true; }
    void setValue(int newValue)   { value = newValue; }
+   void setHandle(const Handle & h)  { handle = h;    }
+   void setExitFrame(unsigned int f) { exitFrame = f; }
    
    // getters
    bool isDead()           const { return dead;   }
@@ -40,14 +49,26 @@ public:
    Velocity getVelocity()  const { return v;      }
    double getRadius()      const { return radius; }
    int getValue()          const { return value;  }
+   const Handle & getHandle()  const { return handle;    }
+   unsigned int getExitFrame() const { return exitFrame; }
 
-   // special functions
-   virtual void death(std::list<Bullet *> & bullets) {}
+   // out of bounds checker, called when the bullet should have left
+   // the screen (see trajectory.h) rather than every frame
+   void escape()
+   {
+      if (isOutOfBounds())
+         kill();
+   }
+
+   // special functions, for code that only has a Bullet
+   virtual void death(std::list<Bullet *> &) {}
    virtual void output() = 0;
-   virtual void input(bool isUp, bool isDown, bool isB) {}
-   virtual void move(std::list<Effect*> &effects);
+   virtual void input(bool, bool, bool) {}
+   virtual void move() = 0;
 
 protected:
+   // inertia
+   void coast() { pt.add(v); }
    bool isOutOfBounds() const
    {
       return (pt.getX() < -radius || pt.getX() >= dimensions.getX() + radius ||
@@ -62,31 +83,74 @@ protected:
    double random(double min, double max);
 };
 
+class Shrapnel;
+
+/*********************************************
+ * BULLET KIND
+ * The base of each concrete bullet. Each kind provides fly(), paint(),
+ * steer(), burst(), and leaveSmoke() as ordinary member functions, so a
+ * loop over bullets of one kind calls them directly. The defaults here
+ * are hidden by the kinds that do more. move(), output(), and input()
+ * forward to them for code that only has a Bullet.
+ *********************************************/
+template <class T>
+class BulletKind : public Bullet
+{
+public:
+   BulletKind(double angle = 0.0, double speed = 30.0, double radius = 5.0, int value = 1) :
+      Bullet(angle, speed, radius, value) {}
+
+   void fly()                                         { coast(); }
+   void steer(bool, bool)                             {          }
+   void burst(std::vector<Shrapnel> &, const Tuning &) const { }
+   void leaveSmoke(Smokes &) const                    {          }
+
+   // every bullet goes straight until steered
+   static Flight flight(const Tuning &) { return { 1.0, 0.0, 0.0 }; }
+
+   // frames until it dies of old age, or 0 if it lives until it hits
+   // something or leaves the screen
+   int getLifetime() const { return 0; }
+
+   void move()                               { static_cast<T *>(this)->fly();         }
+   void output()                             { static_cast<const T *>(this)->paint(); }
+   void input(bool isUp, bool isDown, bool)
+   {
+      static_cast<T *>(this)->steer(isUp, isDown);
+   }
+};
+
 /*********************
  * PELLET
  * Small little bullet
  **********************/
-class Pellet : public Bullet
+class Pellet : public BulletKind<Pellet>
 {
 public:
-   Pellet(double angle, double speed = 15.0) : Bullet(angle, speed, 1.0, 1) {}
+   Pellet(double angle, double speed = TUNING.pelletSpeed) : BulletKind(angle, speed, 1.0, 1) {}
    
-   void output();
+   void paint() const;
 };
 
 /*********************
  * BOMB
  * Things that go "boom"
  **********************/
-class Bomb : public Bullet
+class Bomb : public BulletKind<Bomb>
 {
 private:
-   int timeToDie;
+   int timeToDie;    // frames from launch until it goes off on its own
 public:
-   Bomb(double angle, double speed = 10.0) : Bullet(angle, speed, 4.0, 4), timeToDie(60) {}
+   Bomb(double angle, double speed = TUNING.bombSpeed) : BulletKind(angle, speed, 4.0, 4), timeToDie(60) {}
    
-   void output();
-   void move(std::list<Effect*> & effects);
+   void paint() const;
+   int getLifetime() const { return timeToDie; }
+   void fly()
+   {
+      // do the inertia thing. The game kills it when its time is up
+      coast();
+   }
+   void burst(std::vector<Shrapnel> & shrapnel, const Tuning & tuning) const;
    void death(std::list<Bullet *> & bullets);
 };
 
@@ -94,18 +158,21 @@ public:
  * Shrapnel
  * A piece that broke off of a bomb
  **********************/
-class Shrapnel : public Bullet
+class Shrapnel : public BulletKind<Shrapnel>
 {
 private:
-   int timeToDie;
+   int timeToDie;    // frames from the burst until it is spent
+   Trail<STREEK_LENGTH> streek;  // where it has been, for as long as a streek lasts
 public:
-   Shrapnel(const Bomb & bomb)
+   static constexpr double STREEK_FADE = 0.10;
+
+   Shrapnel(const Bomb & bomb, const Tuning & tuning)
    {
       // how long will this one live?
       timeToDie = random(5, 15);
       
       // The speed and direction is random
-      v.set(random(0.0, 6.2), random(10.0, 15.0));
+      v.set(random(0.0, 6.2), random(tuning.shrapnelSpeedMin, tuning.shrapnelSpeedMax));
       pt = bomb.getPosition();
 
       value = 0;
@@ -113,8 +180,21 @@ public:
       radius = 3.0;
    }
    
-   void output();  
-   void move(std::list<Effect*> & effects);
+   void paint() const;
+   int getLifetime() const { return timeToDie; }
+   void leaveSmoke(Smokes & smoke) const
+   {
+      smoke.add(Smoke<STREEK_LENGTH>(pt, streek, STREEK_FADE));
+   }
+   void fly()
+   {
+      // add to the streek
+      streek.add(pt);
+
+      // do the usual bullet stuff (like inertia). The game kills it
+      // when its time is up
+      coast();
+   }
 };
 
 
@@ -122,18 +202,37 @@ public:
  * MISSILE
  * Guided missiles
  **********************/
-class Missile : public Bullet
+class Missile : public BulletKind<Missile>
 {
 public:
-   Missile(double angle, double speed = 10.0) : Bullet(angle, speed, 1.0, 3) {}
+   Missile(double angle, double speed = TUNING.missileSpeed) : BulletKind(angle, speed, 1.0, 3) {}
+   static constexpr double EXHAUST_FADE = 0.025;
    
-   void output();
-   void input(bool isUp, bool isDown, bool isB)
+   void paint() const;
+   void leaveSmoke(Smokes & smoke) const
+   {
+      smoke.add(Smoke<EXHAUST_LENGTH>(pt, exhaust, EXHAUST_FADE));
+   }
+   void steer(bool isUp, bool isDown)
    {
       if (isUp)
-         v.turn(0.04);
+         v.turn(STEER_UP);
       if (isDown)
-         v.turn(-0.04);
+         v.turn(STEER_DOWN);
+   }
+   void fly()
+   {
+      // leave a trail of exhaust
+      exhaust.add(pt);
+
+      // do the inertia thing
+      coast();
    }
-   void move(std::list<Effect*> & effects);
+
+private:
+   // every steer is the same small turn, so its sine and cosine are kept
+   static const Rotation STEER_UP;
+   static const Rotation STEER_DOWN;
+
+   Trail<EXHAUST_LENGTH> exhaust;   // where it has been, for as long as exhaust lasts
 };
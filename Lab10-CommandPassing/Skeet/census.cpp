@@ -0,0 +1,126 @@
+/***********************************************************************
+ * Source File:
+ *    CENSUS : How many of each kind of thing there are, and what they hold
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Keeping the peaks of each level and writing the census out as CSV.
+ *    Every row has the same columns, so the frames and the levels can go
+ *    in one file and be told apart by the first one:
+ *       scope,frame,level,kind,live,peak,bytes,allocs,frees
+ *    A frame row has the game's peak and its allocs and frees so far.
+ *    A level row has the peak count and the peak bytes of that level,
+ *    and only the allocs and frees made during it.
+ ************************************************************************/
+
+#include "census.h"
+#include <cassert>
+
+/*********************************************
+ * CENSUS : NAME
+ * What a kind is called in the CSV
+ *********************************************/
+const char * Census::name(int kind)
+{
+   static const char * names[NUM_KINDS] =
+   {
+      "Standard", "Floater", "Sinker", "Crazy",
+      "Pellet", "Missile", "Bomb", "Shrapnel",
+      "Fragment", "Smoke", "Points"
+   };
+   assert(kind >= 0 && kind < NUM_KINDS);
+   return names[kind];
+}
+
+/*********************************************
+ * CENSUS : START FRAME
+ * When the level changes, what was counted for the last one is kept
+ * and the new one starts from nothing but what is still live
+ *********************************************/
+void Census::startFrame(unsigned int frame, int level)
+{
+   if (level != this->level)
+   {
+      if (this->level >= 0)
+      {
+         Level done = { this->level, this->frame, {} };
+         for (int kind = 0; kind < NUM_KINDS; kind++)
+            done.counts[kind] = current[kind];
+         levels.push_back(done);
+      }
+      for (auto & count : current)
+         count = { count.live, count.live, count.bytes, 0, 0 };
+      this->level = level;
+   }
+   this->frame = frame;
+}
+
+/*********************************************
+ * CENSUS : TALLY
+ * How many there are of a kind and what they hold, as of the end of
+ * the frame. The level keeps its most bytes, the game its latest
+ *********************************************/
+void Census::tally(int kind, size_t live, size_t bytes)
+{
+   Count & game = total[kind];
+   game.live  = live;
+   game.bytes = bytes;
+   if (live > game.peak)
+      game.peak = live;
+
+   Count & now = current[kind];
+   now.live = live;
+   if (live > now.peak)
+      now.peak = live;
+   if (bytes > now.bytes)
+      now.bytes = bytes;
+}
+
+/*********************************************
+ * CENSUS : WRITE HEADER
+ *********************************************/
+void Census::writeHeader(std::ostream & out)
+{
+   out << "scope,frame,level,kind,live,peak,bytes,allocs,frees\n";
+}
+
+/*********************************************
+ * CENSUS : WRITE ROW
+ *********************************************/
+void Census::writeRow(std::ostream & out, const char * scope, unsigned int frame,
+                      int level, int kind, const Count & count)
+{
+   out << scope       << ','
+       << frame       << ','
+       << level       << ','
+       << name(kind)  << ','
+       << count.live  << ','
+       << count.peak  << ','
+       << count.bytes << ','
+       << count.allocs << ','
+       << count.frees << '\n';
+}
+
+/*********************************************
+ * CENSUS : WRITE FRAME
+ * Every kind, as of the end of the latest frame
+ *********************************************/
+void Census::writeFrame(std::ostream & out) const
+{
+   for (int kind = 0; kind < NUM_KINDS; kind++)
+      writeRow(out, "frame", frame, level, kind, total[kind]);
+}
+
+/*********************************************
+ * CENSUS : WRITE LEVELS
+ * Every kind, for each level that is over and the one that is not
+ *********************************************/
+void Census::writeLevels(std::ostream & out) const
+{
+   for (auto & done : levels)
+      for (int kind = 0; kind < NUM_KINDS; kind++)
+         writeRow(out, "level", done.frame, done.level, kind, done.counts[kind]);
+   if (level >= 0)
+      for (int kind = 0; kind < NUM_KINDS; kind++)
+         writeRow(out, "level", frame, level, kind, current[kind]);
+}
@@ -0,0 +1,88 @@
+/***********************************************************************
+ * Header File:
+ *    CENSUS : How many of each kind of thing there are, and what they hold
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    The game tells the census every time it makes a bird, a bullet, a
+ *    fragment, or a point value, and every time one goes away. Once a
+ *    frame it also says how many of each are live and how many bytes
+ *    they hold. The census keeps the peaks, both for the whole game and
+ *    for each level, and writes it all out as CSV so pools can be sized
+ *    from it. Since the live count comes from the containers and not from
+ *    the tally of makes and frees, a thing that leaks shows up as a live
+ *    count that is less than allocs - frees says it should be.
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+/*********************************************
+ * CENSUS
+ * Live, peak, bytes, allocs, and frees of each kind
+ *********************************************/
+class Census
+{
+public:
+   // everything that is counted. The birds and the bullets are in the
+   // same order as their rosters
+   enum Kind
+   {
+      STANDARD, FLOATER, SINKER, CRAZY,
+      PELLET, MISSILE, BOMB, SHRAPNEL,
+      FRAGMENT, SMOKE, POINTS,
+      NUM_KINDS
+   };
+   static const char * name(int kind);
+
+   // how one kind is doing
+   struct Count
+   {
+      size_t live;      // how many there are right now
+      size_t peak;      // the most there ever were
+      size_t bytes;     // what they hold right now, or at most for a level
+      size_t allocs;    // how many were made
+      size_t frees;     // how many went away
+   };
+
+   Census() : frame(0), level(-1) {}
+
+   // a new frame of this level. A level that just ended is kept
+   void startFrame(unsigned int frame, int level);
+
+   // one thing of a kind was made, or went away
+   void made(int kind, size_t n = 1) { total[kind].allocs += n; current[kind].allocs += n; }
+   void gone(int kind, size_t n = 1) { total[kind].frees  += n; current[kind].frees  += n; }
+
+   // at the end of a frame: how many there are of a kind and what they hold
+   void tally(int kind, size_t live, size_t bytes);
+
+   // since the game began, and since this level began
+   const Count & getTotal(int kind) const { return total[kind];   }
+   const Count & getLevel(int kind) const { return current[kind]; }
+
+   // CSV: one row per kind for this frame, and one per kind for each
+   // level so far, the one being played included
+   static void writeHeader(std::ostream & out);
+   void writeFrame(std::ostream & out) const;
+   void writeLevels(std::ostream & out) const;
+
+private:
+   struct Level
+   {
+      int level;
+      unsigned int frame;           // the last frame of the level
+      Count counts[NUM_KINDS];
+   };
+   static void writeRow(std::ostream & out, const char * scope, unsigned int frame,
+                        int level, int kind, const Count & count);
+
+   Count total[NUM_KINDS] = {};     // the whole game
+   Count current[NUM_KINDS] = {};   // the level being played
+   std::vector<Level> levels;       // the levels that are over
+   unsigned int frame;
+   int level;
+};
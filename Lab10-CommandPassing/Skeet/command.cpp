@@ -0,0 +1,303 @@
+/***********************************************************************
+ * Source File:
+ *    COMMAND : A single timestamped instruction to the game
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    User input is turned into compact command records before it reaches
+ *    the game. The records can be written to a binary stream while playing
+ *    and read back later to replay the session without a window.
+ ************************************************************************/
+
+#include "command.h"
+#include "uiInteract.h"
+#include <cassert>
+#include <algorithm>
+using namespace std;
+
+#ifdef NO_GRAPHICS
+#include "noGraphics.h"  // for the GLUT_KEY_ constants
+#else // !NO_GRAPHICS
+
+#ifdef __APPLE__
+#define GL_SILENCE_DEPRECATION
+#include <GLUT/glut.h>    // for the GLUT_KEY_ constants
+#endif // __APPLE__
+
+#ifdef __linux__
+#include <GL/glut.h>      // for the GLUT_KEY_ constants
+#endif // __linux__
+
+#ifdef _WIN32
+#include <GL/glut.h>      // for the GLUT_KEY_ constants
+#endif // _WIN32
+#endif // NO_GRAPHICS
+
+// a player can only get so far ahead of the gun
+static const size_t MAX_SHOTS_WAITING = 4;
+
+// every log starts with these four bytes. The digit goes up whenever the
+// same commands would play out differently, so old logs are turned away
+#ifdef SKEET_FLOAT32
+static const char MAGIC[4] = { 'S', 'K', 'F', '4' };    // float32 state rounds differently
+#else // !SKEET_FLOAT32
+static const char MAGIC[4] = { 'S', 'K', 'C', '4' };
+#endif // !SKEET_FLOAT32
+
+/******************************************************************
+ * PUT / GET
+ * Integers are always stored little-endian so a log recorded on one
+ * machine replays on any other.
+ ****************************************************************/
+static void put(ostream & out, unsigned long long value, int bytes)
+{
+   for (int i = 0; i < bytes; i++)
+      out.put((char)((value >> (8 * i)) & 0xff));
+}
+static bool get(istream & in, unsigned long long & value, int bytes)
+{
+   value = 0;
+   for (int i = 0; i < bytes; i++)
+   {
+      int c = in.get();
+      if (c == EOF)
+         return false;
+      value |= (unsigned long long)(unsigned char)c << (8 * i);
+   }
+   return true;
+}
+
+/******************************************************************
+ * CLAMP
+ * Key counts grow as long as a key is held; a byte is plenty
+ ****************************************************************/
+static unsigned char clamp(int value)
+{
+   return (unsigned char)(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+/*********************************************
+ * TRANSLATE
+ * Turn the current key state into the commands for this frame
+ *********************************************/
+vector<Command> translate(const UserInput & ui, unsigned int frame)
+{
+   vector<Command> commands;
+   int clockwise        = ui.isUp()   + ui.isRight();
+   int counterclockwise = ui.isDown() + ui.isLeft();
+
+   if (clockwise || counterclockwise)
+   {
+      commands.push_back({ frame, ROTATE_GUN,
+                           clamp(clockwise), clamp(counterclockwise) });
+      commands.push_back({ frame, STEER_MISSILE,
+                           (unsigned char)(clockwise != 0),
+                           (unsigned char)(counterclockwise != 0) });
+   }
+   if (ui.isSpace())
+      commands.push_back({ frame, FIRE_PELLET, 0, 0 });
+   if (ui.isM())
+      commands.push_back({ frame, FIRE_MISSILE, 0, 0 });
+   if (ui.isB())
+      commands.push_back({ frame, FIRE_BOMB, 0, 0 });
+   if (ui.isShift())
+      commands.push_back({ frame, BULLSEYE, 0, 0 });
+
+   return commands;
+}
+
+/*********************************************
+ * KEYBOARD : APPLY
+ * Note one key event, the same keys UserInput listens to
+ *********************************************/
+void Keyboard::apply(const KeyEvent & event)
+{
+   if (!hasEvents)
+   {
+      earliest = event.when;
+      hasEvents = true;
+   }
+   isShift = event.isShift;
+
+   switch (event.key)
+   {
+      case GLUT_KEY_UP:
+         up = event.isDown ? 1 : 0;
+         isUpTapped = isUpTapped || event.isDown;
+         break;
+      case GLUT_KEY_DOWN:
+         down = event.isDown ? 1 : 0;
+         isDownTapped = isDownTapped || event.isDown;
+         break;
+      case GLUT_KEY_LEFT:
+         left = event.isDown ? 1 : 0;
+         isLeftTapped = isLeftTapped || event.isDown;
+         break;
+      case GLUT_KEY_RIGHT:
+         right = event.isDown ? 1 : 0;
+         isRightTapped = isRightTapped || event.isDown;
+         break;
+      case GLUT_KEY_HOME:
+      case ' ':
+         if (event.isDown && shots.size() < MAX_SHOTS_WAITING)
+            shots.push_back(FIRE_PELLET);
+         break;
+      case 'm':
+         if (event.isDown && shots.size() < MAX_SHOTS_WAITING)
+            shots.push_back(FIRE_MISSILE);
+         break;
+      case 'b':
+         if (event.isDown && shots.size() < MAX_SHOTS_WAITING)
+            shots.push_back(FIRE_BOMB);
+         break;
+   }
+}
+
+/*********************************************
+ * KEYBOARD : TRANSLATE
+ * The same commands translate() makes from UserInput. A key
+ * tapped since the last frame counts as held for one frame.
+ *********************************************/
+vector<Command> Keyboard::translate(unsigned int frame)
+{
+   vector<Command> commands;
+   int clockwise        = max(up,   (int)isUpTapped)   + max(right, (int)isRightTapped);
+   int counterclockwise = max(down, (int)isDownTapped) + max(left,  (int)isLeftTapped);
+
+   if (clockwise || counterclockwise)
+   {
+      commands.push_back({ frame, ROTATE_GUN,
+                           clamp(clockwise), clamp(counterclockwise) });
+      commands.push_back({ frame, STEER_MISSILE,
+                           (unsigned char)(clockwise != 0),
+                           (unsigned char)(counterclockwise != 0) });
+   }
+
+   // the game fires at most once a frame
+   if (!shots.empty())
+   {
+      commands.push_back({ frame, shots.front(), 0, 0 });
+      shots.pop_front();
+   }
+   if (isShift)
+      commands.push_back({ frame, BULLSEYE, 0, 0 });
+
+   // held keys have been held one frame longer
+   if (up)    up++;
+   if (down)  down++;
+   if (left)  left++;
+   if (right) right++;
+   isUpTapped = isDownTapped = isLeftTapped = isRightTapped = false;
+
+   return commands;
+}
+
+/*********************************************
+ * KEYBOARD : TAKE EARLIEST
+ * When the oldest event we have not yet reported arrived
+ *********************************************/
+bool Keyboard::takeEarliest(chrono::steady_clock::time_point & when)
+{
+   if (!hasEvents)
+      return false;
+   when = earliest;
+   hasEvents = false;
+   return true;
+}
+
+/*********************************************
+ * COMMAND WRITER constructor
+ * Start a log with the magic number and the random seed
+ *********************************************/
+CommandWriter::CommandWriter(ostream & out, unsigned int seed) :
+   out(out), finished(false)
+{
+   out.write(MAGIC, sizeof(MAGIC));
+   put(out, seed, 4);
+}
+
+/*********************************************
+ * COMMAND WRITER : WRITE
+ * Each record is frame (4), type (1), a (1), b (1), and a pad byte
+ *********************************************/
+void CommandWriter::write(const vector<Command> & commands)
+{
+   assert(!finished);
+   for (auto & command : commands)
+   {
+      put(out, command.frame, 4);
+      put(out, command.type,  1);
+      put(out, command.a,     1);
+      put(out, command.b,     1);
+      put(out, 0,             1);
+   }
+}
+
+/*********************************************
+ * COMMAND WRITER : FINISH
+ * The last record says how long the session was, followed by
+ * the checksum the replay should arrive at
+ *********************************************/
+void CommandWriter::finish(unsigned int frame, unsigned long long checksum)
+{
+   if (finished)
+      return;
+   write({ { frame, END_OF_LOG, 0, 0 } });
+   put(out, checksum, 8);
+   out.flush();
+   finished = true;
+}
+
+/*********************************************
+ * COMMAND LOG : READ
+ * Read an entire session. A log cut short (say, the game crashed)
+ * still replays, but has no checksum to verify against.
+ *********************************************/
+bool CommandLog::read(istream & in)
+{
+   char magic[sizeof(MAGIC)];
+   unsigned long long value;
+
+   commands.clear();
+   complete = false;
+   lastFrame = 0;
+   checksum = 0;
+
+   if (!in.read(magic, sizeof(magic)) ||
+       !equal(magic, magic + sizeof(magic), MAGIC) ||
+       !get(in, value, 4))
+      return false;
+   seed = (unsigned int)value;
+
+   unsigned long long frame, type, a, b, pad;
+   while (get(in, frame, 4) && get(in, type, 1) && get(in, a, 1) &&
+          get(in, b, 1) && get(in, pad, 1))
+   {
+      lastFrame = (unsigned int)frame;
+      if (type == END_OF_LOG)
+      {
+         complete = get(in, checksum, 8);
+         break;
+      }
+      commands.push_back({ (unsigned int)frame, (CommandType)type,
+                           (unsigned char)a, (unsigned char)b });
+   }
+   return true;
+}
+
+/*********************************************
+ * COMMAND LOG : NEXT
+ * Gather the commands for a given frame. The index i walks
+ * forward through the log so replay is linear in the log size.
+ *********************************************/
+vector<Command> CommandLog::next(unsigned int frame, size_t & i) const
+{
+   vector<Command> batch;
+   while (i < commands.size() && commands[i].frame <= frame)
+   {
+      if (commands[i].frame == frame)
+         batch.push_back(commands[i]);
+      i++;
+   }
+   return batch;
+}
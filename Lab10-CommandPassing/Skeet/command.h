@@ -0,0 +1,134 @@
+/***********************************************************************
+ * Header File:
+ *    COMMAND : A single timestamped instruction to the game
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    User input is turned into compact command records before it reaches
+ *    the game. The records can be written to a binary stream while playing
+ *    and read back later to replay the session without a window.
+ ************************************************************************/
+
+#pragma once
+
+#include "eventQueue.h"
+#include <deque>
+#include <vector>
+#include <iostream>
+
+class UserInput;
+
+/*********************************************
+ * COMMAND TYPE
+ * What the player asked the game to do
+ *********************************************/
+enum CommandType : unsigned char
+{
+   ROTATE_GUN    = 1,   // a: clockwise count,  b: counterclockwise count
+   FIRE_PELLET   = 2,   // also restarts the game when it is over
+   FIRE_MISSILE  = 3,
+   FIRE_BOMB     = 4,
+   STEER_MISSILE = 5,   // a: up,  b: down
+   BULLSEYE      = 6,   // the crosshairs are showing this frame
+   END_OF_LOG    = 255  // last frame of the session, followed by a checksum
+};
+
+/*********************************************
+ * COMMAND
+ * One instruction, stamped with the frame it applies to.
+ * Stored on disk as exactly eight bytes.
+ *********************************************/
+struct Command
+{
+   unsigned int  frame;   // the frame (animate count) this happens before
+   CommandType   type;    // what to do
+   unsigned char a;       // first argument, meaning depends on the type
+   unsigned char b;       // second argument
+};
+
+// turn the current key state into the commands for this frame
+std::vector<Command> translate(const UserInput & ui, unsigned int frame);
+
+/*********************************************
+ * KEYBOARD
+ * The player's keys as the simulation sees them, rebuilt from the
+ * stream of key events. Nothing is lost between frames: an arrow
+ * tapped and released within one frame still turns the gun for that
+ * frame, and shots pressed faster than the game can fire wait their
+ * turn, one per frame.
+ *********************************************/
+class Keyboard
+{
+public:
+   Keyboard() : up(0), down(0), left(0), right(0),
+      isUpTapped(false), isDownTapped(false),
+      isLeftTapped(false), isRightTapped(false),
+      isShift(false), hasEvents(false) {}
+
+   // one key went up or down
+   void apply(const KeyEvent & event);
+
+   // the commands for this frame. Held keys count one more frame
+   std::vector<Command> translate(unsigned int frame);
+
+   // the earliest event since the last call, if there was one
+   bool takeEarliest(std::chrono::steady_clock::time_point & when);
+
+private:
+   int up, down, left, right;         // frames held, 0 if not held
+   bool isUpTapped, isDownTapped;     // pressed since the last frame
+   bool isLeftTapped, isRightTapped;
+   bool isShift;
+   std::deque<CommandType> shots;     // fire commands not yet sent
+   bool hasEvents;
+   std::chrono::steady_clock::time_point earliest;
+};
+
+/*********************************************
+ * COMMAND WRITER
+ * Log commands to a binary stream as they happen
+ *********************************************/
+class CommandWriter
+{
+public:
+   CommandWriter(std::ostream & out, unsigned int seed);
+
+   // add one frame worth of commands to the log
+   void write(const std::vector<Command> & commands);
+
+   // close out the log with the final frame and state checksum
+   void finish(unsigned int frame, unsigned long long checksum);
+
+private:
+   std::ostream & out;
+   bool finished;
+};
+
+/*********************************************
+ * COMMAND LOG
+ * A complete recorded session read back from a binary stream
+ *********************************************/
+class CommandLog
+{
+public:
+   CommandLog() : seed(0), lastFrame(0), checksum(0), complete(false) {}
+
+   // read a session. Returns false if the stream is not a command log
+   bool read(std::istream & in);
+
+   // the commands that apply to a given frame, starting at position i
+   std::vector<Command> next(unsigned int frame, size_t & i) const;
+
+   unsigned int       getSeed()      const { return seed;      }
+   unsigned int       getLastFrame() const { return lastFrame; }
+   unsigned long long getChecksum()  const { return checksum;  }
+   bool               isComplete()   const { return complete;  }
+   size_t             size()         const { return commands.size(); }
+
+private:
+   std::vector<Command> commands;  // every command, in frame order
+   unsigned int seed;              // what srand() was given at the start
+   unsigned int lastFrame;         // number of frames in the session
+   unsigned long long checksum;    // state of the game at the end
+   bool complete;                  // did we find the END_OF_LOG record?
+};
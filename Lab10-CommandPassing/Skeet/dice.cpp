@@ -0,0 +1,15 @@
+/***********************************************************************
+ * Source File:
+ *    DICE : Where the game's random numbers come from
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Normally the game rolls rand(), so srand() decides how it goes.
+ *    Many games running at once on many threads cannot share rand(), so
+ *    each can bring its own dice: while a Dice::Use is in scope, every
+ *    roll on that thread comes from those dice instead.
+ ************************************************************************/
+
+#include "dice.h"
+
+thread_local Dice * Dice::pCurrent = nullptr;
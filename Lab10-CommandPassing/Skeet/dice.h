@@ -0,0 +1,102 @@
+/***********************************************************************
+ * Header File:
+ *    DICE : Where the game's random numbers come from
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Normally the game rolls rand(), so srand() decides how it goes.
+ *    Many games running at once on many threads cannot share rand(), so
+ *    each can bring its own dice: while a Dice::Use is in scope, every
+ *    roll on that thread comes from those dice instead.
+ ************************************************************************/
+
+#pragma once
+
+#include <cstdlib>
+#include <cmath>
+
+/*********************************************
+ * DICE
+ * A small, fast, seedable generator, one per game
+ *********************************************/
+class Dice
+{
+public:
+   Dice(unsigned long long seed = 0) : state(seed) {}
+
+   // the same range as rand(): 0 through RAND_MAX
+   int roll()
+   {
+      // splitmix64
+      unsigned long long z = (state += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      z ^= z >> 31;
+      return (int)(z % ((unsigned long long)RAND_MAX + 1));
+   }
+
+   // roll these dice on this thread until the Use goes out of scope
+   class Use
+   {
+   public:
+      Use(Dice & dice) : pPrevious(pCurrent) { pCurrent = &dice; }
+      ~Use()                                 { pCurrent = pPrevious; }
+   private:
+      Dice * pPrevious;
+   };
+
+   // the dice in use on this thread, or nullptr for rand()
+   static thread_local Dice * pCurrent;
+
+private:
+   unsigned long long state;
+};
+
+/*********************************************
+ * ROLL
+ * Every random number in the game starts here
+ *********************************************/
+inline int roll()
+{
+   return Dice::pCurrent ? Dice::pCurrent->roll() : rand();
+}
+
+/*********************************************
+ * ROLL WAIT
+ * Something has a 1 in oneIn chance of happening each frame. How many
+ * frames until it next does, counting the one it happens on? That is
+ * geometric: more than k frames with probability (1 - 1/oneIn)^k.
+ * One roll gives the same odds as rolling every frame. The longest wait
+ * is about 22 * oneIn, so oneIn has to stay well under INT_MAX / 22.
+ *********************************************/
+inline int rollWait(int oneIn)
+{
+   double u = (roll() + 1.0) / ((double)RAND_MAX + 1.0);     // (0, 1]
+   return 1 + (int)floor(log(u) / log(1.0 - 1.0 / oneIn));
+}
+
+/*********************************************
+ * CHANCE
+ * Stands in for rolling a 1 in oneIn chance every time it is asked.
+ * It only rolls when the thing happens, to see how long until the
+ * next time.
+ *********************************************/
+class Chance
+{
+public:
+   Chance() : frames(0) {}
+
+   // true about once in every oneIn calls
+   bool happens(int oneIn)
+   {
+      if (frames == 0)
+         frames = rollWait(oneIn);
+      return --frames == 0;
+   }
+
+   // forget the wait; the next call rolls a new one
+   void reset() { frames = 0; }
+
+private:
+   int frames;       // calls until it happens, counting that one
+};
@@ -8,8 +8,13 @@
  ************************************************************************/
 
 #include "effect.h"
+#include "dice.h"
 #include <cassert>
 
+#ifdef NO_GRAPHICS
+#include "noGraphics.h"  // draw nothing: no OpenGL, no GLUT
+#else // !NO_GRAPHICS
+
 #ifdef __APPLE__
 #define GL_SILENCE_DEPRECATION
 #include <openGL/gl.h>    // Main OpenGL library
@@ -31,6 +36,7 @@
 #include <math.h>
 #define GLUT_TEXT GLUT_BITMAP_HELVETICA_12
 #endif // _WIN32
+#endif // NO_GRAPHICS
 
 /******************************************************************
  * RANDOM
@@ -39,7 +45,7 @@
 double random(double min, double max)
 {
    assert(min <= max);
-   double num = min + ((double)rand() / (double)RAND_MAX * (max - min));
+   double num = min + ((double)roll() / (double)RAND_MAX * (max - min));
    assert(min <= num && num <= max);
    return num;
 }
@@ -55,7 +61,7 @@ double random(double min, double max)
 /************************************************************************
  * FRAGMENT constructor
  *************************************************************************/
-Fragment::Fragment(const Position & pt, const Velocity & v) : Effect(pt)
+Fragment::Fragment(const Position & pt, const Velocity & v) : Effect(pt, 0.02)
 {
    // the velocity is a random kick plus the velocity of the thing that died
    this->v.setDx(v.getDx() * 0.5 + random(-6.0, 6.0));
@@ -68,32 +74,6 @@ Fragment::Fragment(const Position & pt, const Velocity & v) : Effect(pt)
     size = random(1.0, 2.5);
 }
 
-/************************************************************************
- * STREEK constructor
- *************************************************************************/
-Streek::Streek(const Position & pt, Velocity v) : Effect(pt)
-{
-   ptEnd = pt;
-   v *= -1.0;
-   ptEnd += v;
-   
-    // age
-    age = 0.5;
-}
-
-/************************************************************************
- * EXHAUST constructor
- *************************************************************************/
-Exhaust::Exhaust(const Position & pt, Velocity v) : Effect(pt)
-{
-    ptEnd = pt;
-    v *= -1.0;
-    ptEnd += v;
-
-    // age
-    age = 0.5;
-}
-
 /***************************************************************/
 /***************************************************************/
 /*                           RENDER                            */
@@ -126,45 +106,28 @@ void Fragment::render() const
 }
 
 /************************************************************************
- * STREEK RENDER
- * Draw the shrapnel streek on the screen
- *************************************************************************/
-void Streek::render() const
-{
-    // Do nothing if we are already dead
-    if (isDead())
-        return;
-    
-    // Draw this sucker
-    glBegin(GL_LINES);
-    glColor3f((GLfloat)age, (GLfloat)age, (GLfloat)age);
-
-    // Draw the actual line
-    glVertex2f((GLfloat)pt.getX(), (GLfloat)pt.getY());
-    glVertex2f((GLfloat)ptEnd.getX(), (GLfloat)ptEnd.getY());
-
-    glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)1.0 /* blue % */);
-    glEnd();
-}
-
-/************************************************************************
- * EXHAUST RENDER
- * Draw a missile exhaust on the screen
+ * DRAW TRAIL
+ * Draw a trail on the screen as one line, newest place first. The piece
+ * k places back is as old as a streek left k frames before the newest,
+ * so it fades the same way one would have
  *************************************************************************/
-void Exhaust::render() const
+void drawTrail(const Vec2Of<float> * places, int capacity, int newest, int count,
+               double age, double fade)
 {
-   // Do nothing if we are already dead
-   if (isDead())
-       return;
-   
-   // Draw this sucker
-   glBegin(GL_LINES);
-   glColor3f((GLfloat)age, (GLfloat)age, (GLfloat)age);
-
-   // Draw the actual line
-   glVertex2f((GLfloat)pt.getX(), (GLfloat)pt.getY());
-   glVertex2f((GLfloat)ptEnd.getX(), (GLfloat)ptEnd.getY());
-
+   // Need two places for a line
+   if (count < 2)
+      return;
+
+   glBegin(GL_LINE_STRIP);
+   for (int k = 0; k < count; k++)
+   {
+      const Vec2Of<float> & place = places[(newest - k + capacity) % capacity];
+      double bright = age - k * fade;
+      if (bright < 0.0)
+         bright = 0.0;
+      glColor3f((GLfloat)bright, (GLfloat)bright, (GLfloat)bright);
+      glVertex2f((GLfloat)place.x, (GLfloat)place.y);
+   }
    glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)1.0 /* blue % */);
    glEnd();
 }
@@ -185,32 +148,18 @@ void Fragment :: fly()
     pt += v;
     
     // increase the age so it fades away
-    age -= 0.02;
+    age -= fade;
     size *= 0.95;
 }
 
-/************************************************************************
- * STREEK FLY
- * The streek will just fade away
- *************************************************************************/
-void Streek :: fly()
-{
-    // move it forward with inertia (no gravity)
-//    pt += v;
-    
-   // increase the age so it fades away
-   age -= 0.10;
-}
+/***************************************************************/
+/***************************************************************/
+/*                           COPY                              */
+/***************************************************************/
+/***************************************************************/
 
 /************************************************************************
- * EXHAUST FLY
- * The exhaust will just fade away
+ * COPY INTO
+ * Put a copy of this effect with the others of its kind
  *************************************************************************/
-void Exhaust :: fly()
-{
-   // move it forward with inertia (no gravity)
-//   pt += v;
-    
-   // increase the age so it fades away
-   age -= 0.025;
-}
+void Fragment::copyInto(EffectCopies & copies) const { copies.add(*this); }
@@ -9,6 +9,21 @@
 
 #pragma once
 #include "position.h"
+#include "roster.h"
+#include <vector>
+
+class Fragment;
+template <int N> class Smoke;
+
+// how many places the trail of a shrapnel and of a missile keeps
+const int STREEK_LENGTH  = 6;
+const int EXHAUST_LENGTH = 21;
+
+// the smoke a bullet leaves behind, kept by kind
+typedef Roster<Smoke<STREEK_LENGTH>, Smoke<EXHAUST_LENGTH>> Smokes;
+
+// a copy of every effect, kept by kind
+typedef Roster<Fragment, Smoke<STREEK_LENGTH>, Smoke<EXHAUST_LENGTH>> EffectCopies;
 
 /**********************
  * Effect: stuff that is not interactive
@@ -17,19 +32,38 @@ class Effect
 {
 protected:
     Position pt;      // location of the effect
-    double age;    // 1.0 = new, 0.0 = dead
+    Real age;      // 1.0 = new, 0.0 = dead
+    Real fade;     // age lost each frame
 public:
     // create a fragment based on the velocity and position of the bullet
-    Effect(const Position & pt) : pt(pt), age(0.5) {}
+    Effect(const Position & pt, double fade) : pt(pt), age(0.5), fade((Real)fade) {}
+    virtual ~Effect() {}
     
     // draw it
     virtual void render() const = 0;
     
     // move it forward with regards to inertia. Let it age
     virtual void fly() = 0;
+
+    // put a copy of this effect with the others of its kind
+    virtual void copyInto(EffectCopies & copies) const = 0;
     
     // it is dead when age goes to 0.0
     bool isDead() const { return age <= 0.0; }
+
+    // how many more calls to fly() until it is dead. The same sums fly()
+    // does, so the answer is exact to the last bit
+    int getLifetime() const
+    {
+       int frames = 0;
+       for (Real a = age; a > 0.0; a -= fade)
+          frames++;
+       return frames;
+    }
+
+    // getters
+    Position getPosition() const { return pt;  }
+    double   getAge()      const { return age; }
 };
 
 /**********************
@@ -40,7 +74,7 @@ class Fragment : public Effect
 {
 private:
    Velocity v;    // direction the fragment is flying
-   double size;   // size of the fragment
+   Real size;     // size of the fragment
 public:
     // create a fragment based on the velocity and position of the bullet
     Fragment(const Position & pt, const Velocity & v);
@@ -50,42 +84,80 @@ public:
     
     // move it forward with regards to inertia. Let it age
     void fly();
+
+    void copyInto(EffectCopies & copies) const;
 };
 
+// one line strip through count places of a ring, newest first. The
+// newest is age bright, and each one older is fade less
+void drawTrail(const Vec2Of<float> * places, int capacity, int newest, int count,
+               double age, double fade);
+
 /**********************
- * STREEK
- * Stuff that trails off the back of shrapnel
+ * TRAIL
+ * The last N places a bullet has been, in a ring so the oldest is
+ * written over, drawn as one line that fades to black toward the old
+ * end. Each piece fades as a separate streak used to: it starts half
+ * bright and loses fade every frame. The places are kept as floats,
+ * since they are only ever drawn.
  **********************/
-class Streek : public Effect
+template <int N>
+class Trail
 {
-private:
-   Position ptEnd;
 public:
-    // create a fragment based on the velocity and position of the bullet
-    Streek(const Position & pt, Velocity v);
-    
-    // draw it
-    void render() const;
-    
-    // move it forward with regards to inertia. Let it age
-    void fly();
+   Trail() : newest(N - 1), count(0) {}
+
+   // where the bullet is, before it moves this frame
+   void add(const Position & pt)
+   {
+      newest = (newest + 1) % N;
+      places[newest] = { (float)pt.getX(), (float)pt.getY() };
+      if (count < N)
+         count++;
+   }
+
+   // draw it behind a bullet, or, once the bullet is gone, with the
+   // newest place as old as age
+   void render(double fade) const { render(0.5 - fade, fade); }
+   void render(double age, double fade) const
+   {
+      drawTrail(places, N, newest, count, age, fade);
+   }
+
+private:
+   Vec2Of<float> places[N];
+   int newest;     // the place added last
+   int count;      // how many places there are so far
 };
 
 /**********************
- * EXHAUST
- * Stuff that comes out the back of a missile when in flight
+ * SMOKE
+ * The trail of a bullet that is gone. It stays where the
+ * bullet left it and goes on fading as it would have, so
+ * it does not vanish the moment the bullet does.
  **********************/
-class Exhaust : public Effect
+template <int N>
+class Smoke : public Effect
 {
-private:
-   Position ptEnd;
 public:
-    // create a fragment based on the velocity and position of the bullet
-    Exhaust(const Position & pt, Velocity v);
-    
-    // draw it
-    void render() const;
-    
-    // move it forward with regards to inertia. Let it age
-    void fly();
+   Smoke(const Position & pt, const Trail<N> & trail, double fade) :
+      Effect(pt, fade), trail(trail)
+   {
+      age -= this->fade;   // as old as the newest place already is
+   }
+
+   // draw it
+   void render() const
+   {
+      if (!isDead())
+         trail.render(age, fade);
+   }
+
+   // nothing moves; it only gets older
+   void fly() { age -= fade; }
+
+   void copyInto(EffectCopies & copies) const { copies.add(*this); }
+
+private:
+   Trail<N> trail;
 };
@@ -0,0 +1,81 @@
+/***********************************************************************
+ * Header File:
+ *    EVENT QUEUE : Key presses passed from one thread to another
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    The GLUT key callbacks push every key event, stamped with the time
+ *    it arrived, into a ring. The simulation drains the ring once per
+ *    frame. Exactly one thread pushes and exactly one thread pops, so
+ *    the ring needs no locks: each side owns one index and only reads
+ *    the other's.
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+/*********************************************
+ * KEY EVENT
+ * One key going up or down, and when
+ *********************************************/
+struct KeyEvent
+{
+   int  key;                                   // GLUT_KEY_ code or character
+   bool isDown;                                // pressed or released
+   bool isShift;                               // was shift held at the time?
+   std::chrono::steady_clock::time_point when; // when the callback saw it
+};
+
+/*********************************************
+ * SPSC QUEUE
+ * A fixed-size ring for one producer and one consumer.
+ * N must be a power of two.
+ *********************************************/
+template <class T, size_t N>
+class SpscQueue
+{
+   static_assert(N && (N & (N - 1)) == 0, "the ring size must be a power of two");
+public:
+   SpscQueue() : head(0), tail(0), numDropped(0) {}
+
+   // producer: add to the end. If the ring is full the item is dropped
+   bool push(const T & t)
+   {
+      size_t h = head.load(std::memory_order_relaxed);
+      if (h - tail.load(std::memory_order_acquire) == N)
+      {
+         numDropped.store(numDropped.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_relaxed);
+         return false;
+      }
+      slots[h & (N - 1)] = t;
+      head.store(h + 1, std::memory_order_release);
+      return true;
+   }
+
+   // consumer: take from the front. False if there is nothing there
+   bool pop(T & t)
+   {
+      size_t tl = tail.load(std::memory_order_relaxed);
+      if (tl == head.load(std::memory_order_acquire))
+         return false;
+      t = slots[tl & (N - 1)];
+      tail.store(tl + 1, std::memory_order_release);
+      return true;
+   }
+
+   // how many pushes found the ring full?
+   size_t getDropped() const { return numDropped.load(std::memory_order_relaxed); }
+
+private:
+   T slots[N];
+   alignas(64) std::atomic<size_t> head;       // next slot to fill, producer's
+   alignas(64) std::atomic<size_t> tail;       // next slot to empty, consumer's
+   std::atomic<size_t> numDropped;
+};
+
+// a few seconds of frantic typing
+typedef SpscQueue<KeyEvent, 256> KeyEventQueue;
@@ -10,6 +10,15 @@
 #include "uiInteract.h"
 #include "skeet.h"
 #include "position.h"
+#include "command.h"
+#include "pipeline.h"
+#include "tuning.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
 
 #define WIDTH  800.0
 #define HEIGHT 800.0
@@ -17,30 +26,125 @@
 Position Bullet::dimensions(WIDTH, HEIGHT);
 Position Bird::dimensions(WIDTH, HEIGHT);
 
+// when recording, every command the player issues goes here
+static std::ofstream   fileRecord;
+static CommandWriter * pRecorder = nullptr;
+static Skeet *         pRecorded = nullptr;
+
+// the simulation thread, fed by the GLUT thread
+static Pipeline *      pPipeline = nullptr;
+
+// when playing with a tuning file, what notices it changed
+static TuningWatcher * pWatcher = nullptr;
+
  /*************************************
   * All the interesting work happens here, when
   * I get called back from OpenGL to output a frame.
-  * When I am finished drawing, then the graphics
-  * engine will wait until the proper amount of
-  * time has passed and put the drawing on the screen.
+  * The game moves on its own thread and gets the
+  * player's keys straight from the key callbacks; all
+  * we do here is draw the newest snapshot it published.
   **************************************/
-void callBack(const UserInput* pUI, void* p)
+void callBack(const UserInput*, void* p)
 {
    // the first step is to cast the void pointer into a game object. This
    // is the first step of every single callback function in OpenGL. 
-   Skeet* pSkeet = (Skeet*)p;
-
-   // handle user input
-   pSkeet->interact(*pUI);
-
-   // move the stuff
-   pSkeet->animate();
+   Pipeline* pGame = (Pipeline*)p;
 
    // output the stuff
-   if (pSkeet->isPlaying())
-      pSkeet->drawLevel();
+   const Snapshot & snapshot = pGame->acquire();
+   if (snapshot.isPlaying())
+      snapshot.drawLevel();
    else
-      pSkeet->drawStatus();
+      snapshot.drawStatus();
+}
+
+/*************************************
+ * SHUT DOWN
+ * GLUT leaves by calling exit(), so stop the simulation, report
+ * how it went, and close out the log from atexit()
+ **************************************/
+void shutDown()
+{
+   if (!pPipeline)
+      return;
+   pPipeline->stop();
+   std::cout << pPipeline->report();
+   if (pRecorder && pRecorded)
+      pRecorder->finish(pRecorded->getFrame(), pRecorded->checksum());
+   pPipeline = nullptr;
+}
+
+/*************************************
+ * REPLAY
+ * Run a recorded session through the game without a window,
+ * as fast as the machine will go, and verify the final state.
+ * The result must not depend on how many threads help out. Given
+ * a census file, every frame's census and then every level's go
+ * there as CSV. Tuning and levels read from a file play out
+ * differently, so they will not match a recording made without them.
+ **************************************/
+int replay(const char * fileName, unsigned int numThreads, const char * censusName,
+           std::shared_ptr<const Tuning> pTuning, const LevelTable * pLevels)
+{
+   std::ifstream fin(fileName, std::ios::binary);
+   CommandLog log;
+   if (!fin || !log.read(fin))
+   {
+      std::cerr << "Unable to read command log " << fileName << std::endl;
+      return 1;
+   }
+
+   // same seed, same commands, same frames: same game
+   srand(log.getSeed());
+   Position dimensions(WIDTH, HEIGHT);
+   JobSystem jobs(numThreads);
+   Skeet skeet(dimensions, jobs);
+   if (pTuning)
+      skeet.setTuning(pTuning);
+   if (pLevels)
+      skeet.setLevels(*pLevels);
+
+   std::ofstream fileCensus;
+   if (censusName)
+   {
+      fileCensus.open(censusName);
+      if (!fileCensus)
+      {
+         std::cerr << "Unable to write census " << censusName << std::endl;
+         return 1;
+      }
+      Census::writeHeader(fileCensus);
+   }
+
+   auto start = std::chrono::steady_clock::now();
+   size_t i = 0;
+   while (skeet.getFrame() < log.getLastFrame())
+   {
+      skeet.execute(log.next(skeet.getFrame(), i));
+      skeet.animate();
+      if (censusName)
+         skeet.getCensus().writeFrame(fileCensus);
+   }
+   std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+   if (censusName)
+      skeet.getCensus().writeLevels(fileCensus);
+
+   std::cout << "threads:    " << jobs.size() << "\n"
+             << "frames:     " << skeet.getFrame() << "\n"
+             << "commands:   " << log.size() << "\n"
+             << "seconds:    " << elapsed.count() << "\n"
+             << "frames/sec: " << skeet.getFrame() / std::max(elapsed.count(), 1e-9) << "\n"
+             << "checksum:   " << std::hex << skeet.checksum() << std::dec << "\n";
+
+   if (!log.isComplete())
+   {
+      std::cout << "log is incomplete, nothing to verify against" << std::endl;
+      return 0;
+   }
+   bool isMatch = skeet.checksum() == log.getChecksum();
+   std::cout << (isMatch ? "replay matches the recording" :
+                           "REPLAY DIVERGED from the recording") << std::endl;
+   return isMatch ? 0 : 2;
 }
 
 /*********************************
@@ -59,6 +163,78 @@ int WINAPI wWinMain(
 int main(int argc, char** argv)
 #endif // !_WIN32
 {
+   // skeet --compile-tuning <text> <file> : turn the text form of the
+   // tuning (see tuning.h) into a tuning file. What the text leaves out
+   // is what the game ships with
+   if (argc > 3 && std::string(argv[1]) == "--compile-tuning")
+   {
+      Tuning tuning = TUNING;
+      std::ifstream fin(argv[2]);
+      if (!fin || !readTuning(fin, tuning) || !writeTuning(argv[3], tuning))
+      {
+         std::cerr << "Unable to compile " << argv[2] << " into " << argv[3] << std::endl;
+         return 1;
+      }
+      return 0;
+   }
+
+   // skeet --print-tuning [file] : the text form of a tuning file, or of
+   // the numbers the game ships with
+   if (argc > 1 && std::string(argv[1]) == "--print-tuning")
+   {
+      std::shared_ptr<const Tuning> pTuning = argc > 2 ? loadTuning(argv[2]) : builtInTuning();
+      if (!pTuning)
+      {
+         std::cerr << "Unable to read tuning " << argv[2] << std::endl;
+         return 1;
+      }
+      writeTuningText(std::cout, *pTuning);
+      return 0;
+   }
+
+   // skeet --tuning <file> ... : play with the numbers in a tuning file,
+   // and while playing, pick up each new version of it between frames.
+   // skeet --levels <file> ... : play the levels in the file (see levels.h)
+   // instead of the ones built in, or the ones any tuning file brings.
+   // Either goes with any option below
+   std::shared_ptr<const Tuning> pTuning;
+   LevelTable levels;
+   const LevelTable * pLevels = nullptr;
+   while (argc > 2)
+   {
+      std::string option = argv[1];
+      if (option == "--tuning")
+      {
+         pWatcher = new TuningWatcher(argv[2]);
+         pTuning = pWatcher->first();
+         if (!pTuning)
+         {
+            std::cerr << "Unable to read tuning " << argv[2] << std::endl;
+            return 1;
+         }
+      }
+      else if (option == "--levels")
+      {
+         std::ifstream fin(argv[2]);
+         if (!fin || !readLevels(fin, levels))
+         {
+            std::cerr << "Unable to read levels " << argv[2] << std::endl;
+            return 1;
+         }
+         pLevels = &levels;
+      }
+      else
+         break;
+      argc -= 2;
+      argv += 2;
+   }
+
+   // skeet --replay <file> [threads] [census.csv] : play back a recorded
+   // session headless, optionally writing out the census
+   if (argc > 2 && std::string(argv[1]) == "--replay")
+      return replay(argv[2], argc > 3 ? (unsigned int)atoi(argv[3]) : 0,
+                    argc > 4 ? argv[4] : nullptr, pTuning, pLevels);
+
    // initialize OpenGL
    Position dimensions(WIDTH, HEIGHT);
    UserInput ui(0, NULL,
@@ -67,9 +243,41 @@ int main(int argc, char** argv)
 
    // initialize the game class
    Skeet skeet(dimensions);
+   if (pTuning)
+      skeet.setTuning(pTuning);
+   if (pLevels)
+      skeet.setLevels(*pLevels);
+
+   // skeet --record <file> : play normally, logging every command
+   if (argc > 2 && std::string(argv[1]) == "--record")
+   {
+      unsigned int seed = (unsigned int)::time(NULL);
+      srand(seed);
+      fileRecord.open(argv[2], std::ios::binary);
+      if (!fileRecord)
+      {
+         std::cerr << "Unable to write command log " << argv[2] << std::endl;
+         return 1;
+      }
+      pRecorder = new CommandWriter(fileRecord, seed);
+      pRecorded = &skeet;
+   }
+
+   // skeet --autopilot : let the game play itself, as a steady load
+   Autopilot autopilot;
+   bool isAutopilot = argc > 1 && std::string(argv[1]) == "--autopilot";
 
    // set everything into action
-   ui.run(callBack, &skeet);
+   Pipeline pipeline(skeet, pRecorder);
+   if (isAutopilot)
+      pipeline.setAutopilot(&autopilot);
+   pipeline.setTuning(pWatcher);
+   pPipeline = &pipeline;
+   ui.setEventQueue(&pipeline.getEvents());
+   atexit(shutDown);
+   pipeline.start();
+   ui.run(callBack, &pipeline);
+   shutDown();
 
    return 0;
 }
@@ -9,6 +9,10 @@
 
 #include "gun.h"
 
+#ifdef NO_GRAPHICS
+#include "noGraphics.h"  // draw nothing: no OpenGL, no GLUT
+#else // !NO_GRAPHICS
+
 #ifdef __APPLE__
 #define GL_SILENCE_DEPRECATION
 #include <openGL/gl.h>    // Main OpenGL library
@@ -30,23 +34,21 @@
 #include <math.h>
 #define GLUT_TEXT GLUT_BITMAP_HELVETICA_12
 #endif // _WIN32
+#endif // NO_GRAPHICS
 
  /************************************************************************
   * ROTATE
-  * Rotate a given point (point) around a given origin (center) by a given
-  * number of degrees (angle).
+  * Rotate a given point (point) around a given origin (center) by the
+  * angle whose cosine and sine are given.
   *    INPUT  origin   The center point we will rotate around
   *           x,y      Offset from center that we will be rotating
-  *           rotation Rotation in degrees
+  *           cosA     Cosine of the rotation
+  *           sinA     Sine of the rotation
   *    OUTPUT point    The new position
   *************************************************************************/
-Position rotate(const Position& origin,
-   double x, double y, double rotation) 
+static Position rotate(const Position& origin,
+   double x, double y, double cosA, double sinA)
 {
-   // because sine and cosine are expensive, we want to call them only once
-   double cosA = cos(rotation);
-   double sinA = sin(rotation);
-
    // start with our original point
    Position ptReturn(origin);
 
@@ -66,32 +68,23 @@ inline void glVertexPoint(const Position& point)
    glVertex2f((GLfloat)point.getX(), (GLfloat)point.getY());
 }
 
-/************************************************************************
- * DRAW RECTANGLE
- * Draw a rectangle on the screen from the beginning to the end.
- *************************************************************************/
-void drawRectangle(const Position& pt,
-                   double angle = 0.0,
-                   double width = 10.0,
-                   double height = 100.0,
-                   double red = 1.0,
-                   double green = 1.0,
-                   double blue = 1.0)
+/*********************************************
+ * GUN : AIM
+ * The barrel is a 10 x 100 rectangle centered on the gun. Because sine
+ * and cosine are expensive, the corners are worked out only when the
+ * gun moves, not every time it is drawn.
+ *********************************************/
+void Gun::aim()
 {
-   // Get ready...
-   glBegin(GL_QUADS);
-   glColor3f((GLfloat)red, (GLfloat)green, (GLfloat)blue);
-
-   // Draw the actual line
-   glVertexPoint(rotate(pt,  width / 2.0,  height / 2.0, angle));
-   glVertexPoint(rotate(pt,  width / 2.0, -height / 2.0, angle));
-   glVertexPoint(rotate(pt, -width / 2.0, -height / 2.0, angle));
-   glVertexPoint(rotate(pt, -width / 2.0,  height / 2.0, angle));
-   glVertexPoint(rotate(pt,  width / 2.0,  height / 2.0, angle));
+   const double width = 10.0;
+   const double height = 100.0;
+   double cosA = cos(M_PI_2 - angle);
+   double sinA = sin(M_PI_2 - angle);
 
-   // Complete drawing
-   glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)1.0 /* blue % */);
-   glEnd();
+   corners[0] = rotate(pt,  width / 2.0,  height / 2.0, cosA, sinA);
+   corners[1] = rotate(pt,  width / 2.0, -height / 2.0, cosA, sinA);
+   corners[2] = rotate(pt, -width / 2.0, -height / 2.0, cosA, sinA);
+   corners[3] = rotate(pt, -width / 2.0,  height / 2.0, cosA, sinA);
 }
 
  /*********************************************
@@ -100,7 +93,20 @@ void drawRectangle(const Position& pt,
   *********************************************/
 void Gun::display() const
 {
-   drawRectangle(pt, M_PI_2 - angle, 10.0, 100.0, 1.0, 1.0, 1.0);
+   // Get ready...
+   glBegin(GL_QUADS);
+   glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)1.0 /* blue % */);
+
+   // Draw the barrel
+   glVertexPoint(corners[0]);
+   glVertexPoint(corners[1]);
+   glVertexPoint(corners[2]);
+   glVertexPoint(corners[3]);
+   glVertexPoint(corners[0]);
+
+   // Complete drawing
+   glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)1.0 /* blue % */);
+   glEnd();
 }
 
 /*********************************************
@@ -109,6 +115,8 @@ void Gun::display() const
  *********************************************/
 void Gun::interact(int clockwise, int counterclockwise)
 {
+   double was = angle;
+
    // move it
    if (clockwise > 0)
    {
@@ -122,4 +130,8 @@ void Gun::interact(int clockwise, int counterclockwise)
       if (angle < 0.0)
          angle = 0.0;
    }
+
+   // only a moving gun needs its barrel worked out again
+   if (angle != was)
+      aim();
 }
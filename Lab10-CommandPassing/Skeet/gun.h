@@ -17,12 +17,16 @@
 class Gun
 {
 public:
-   Gun(const Position & pt) : angle(0.78 /* 45 degrees */), pt(pt) {}  // 45 degrees initially
+   Gun(const Position & pt) : angle(0.78 /* 45 degrees */), pt(pt) { aim(); }  // 45 degrees initially
    void display() const;
    void interact(int clockwise, int counterclockwise);
    double getAngle() const { return angle; }
    
 private:
+   // work out where the corners of the barrel are, after angle changes
+   void aim();
+
    double angle;
    Position pt;
+   Position corners[4];   // the barrel, rotated to angle
 };
@@ -0,0 +1,113 @@
+/***********************************************************************
+ * Header File:
+ *    HANDLE : A way to refer to a bird or bullet that may move or die
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Birds and bullets live in vectors that are compacted every frame,
+ *    so a pointer or an index into one is only good until the next
+ *    removal. A handle names a slot in a slot map instead. The slot
+ *    knows where its thing is now, and it counts how many times it has
+ *    been used. A handle from an earlier use no longer matches the
+ *    count, so asking whether a handle is still good, and where its
+ *    thing is, each take one look at one slot.
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/*********************************************
+ * HANDLE
+ * A slot and which use of it
+ *********************************************/
+struct Handle
+{
+   unsigned int index;        // which slot
+   unsigned int generation;   // ... and how many times it had been used before
+
+   bool operator == (const Handle & rhs) const
+   {
+      return index == rhs.index && generation == rhs.generation;
+   }
+   bool operator != (const Handle & rhs) const { return !(*this == rhs); }
+};
+
+// the handle of something that was never put in a slot map
+const Handle NO_HANDLE = { ~0u, 0 };
+
+/*********************************************
+ * SLOT MAP
+ * Where each handle's thing is in its vector. Freed
+ * slots are used again, most recently freed first.
+ *********************************************/
+class SlotMap
+{
+public:
+   // a new handle for the thing at this place in its vector
+   Handle insert(size_t place)
+   {
+      unsigned int index;
+      if (freeSlots.empty())
+      {
+         index = (unsigned int)slots.size();
+         slots.push_back({ 0, 0 });
+      }
+      else
+      {
+         index = freeSlots.back();
+         freeSlots.pop_back();
+      }
+      slots[index].place = (unsigned int)place;
+      return { index, slots[index].generation };
+   }
+
+   // the thing moved to another place in its vector
+   void move(const Handle & handle, size_t place)
+   {
+      slots[handle.index].place = (unsigned int)place;
+   }
+
+   // the thing is gone, and every copy of its handle is no good
+   void erase(const Handle & handle)
+   {
+      slots[handle.index].generation++;
+      freeSlots.push_back(handle.index);
+   }
+
+   // does the handle still name something, and if so, where is it?
+   bool isValid(const Handle & handle) const
+   {
+      // erase() moves the generation on, so a free slot never matches
+      return handle.index < slots.size() &&
+             slots[handle.index].generation == handle.generation;
+   }
+   size_t find(const Handle & handle) const
+   {
+      return slots[handle.index].place;
+   }
+
+   // everything is gone at once; the slots are kept for next time
+   void clear()
+   {
+      freeSlots.clear();
+      for (size_t i = slots.size(); i > 0; i--)
+      {
+         slots[i - 1].generation++;
+         freeSlots.push_back((unsigned int)(i - 1));
+      }
+   }
+
+   // how many handles are good right now
+   size_t size() const { return slots.size() - freeSlots.size(); }
+
+private:
+   struct Slot
+   {
+      unsigned int place;        // where the thing is in its vector
+      unsigned int generation;   // uses of this slot before the current one
+   };
+   std::vector<Slot> slots;
+   std::vector<unsigned int> freeSlots;
+};
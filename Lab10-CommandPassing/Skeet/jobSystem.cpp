@@ -0,0 +1,174 @@
+/***********************************************************************
+ * Source File:
+ *    JOB SYSTEM : Spread a loop across every core
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    A pool of worker threads, each with its own queue of jobs. A worker
+ *    takes from the back of its own queue and, when that runs dry, steals
+ *    from the front of someone else's. parallelFor() cuts a range into
+ *    chunks, deals them out, and helps with the work until it is done.
+ ************************************************************************/
+
+#include "jobSystem.h"
+#include <algorithm>
+#include <cassert>
+using namespace std;
+
+// set on the pool's own threads so a loop inside a job runs in place
+static thread_local bool isWorkerThread = false;
+
+/*********************************************
+ * JOB SYSTEM constructor
+ * Start a worker for every thread beyond the caller's
+ *********************************************/
+JobSystem::JobSystem(unsigned int numThreads) : numPending(0), isDone(false)
+{
+   if (numThreads == 0)
+      numThreads = max(1u, thread::hardware_concurrency());
+
+   for (unsigned int i = 0; i < numThreads; i++)
+      queues.push_back(unique_ptr<Queue>(new Queue));
+   for (unsigned int i = 1; i < numThreads; i++)
+      workers.push_back(thread(&JobSystem::work, this, (size_t)i));
+}
+
+/*********************************************
+ * JOB SYSTEM destructor
+ * Wake everyone up and wait for them to leave
+ *********************************************/
+JobSystem::~JobSystem()
+{
+   {
+      lock_guard<mutex> guard(sleepLock);
+      isDone = true;
+   }
+   wakeUp.notify_all();
+   for (auto & worker : workers)
+      worker.join();
+}
+
+/*********************************************
+ * JOB SYSTEM : SHARED
+ * Made the first time somebody asks for it
+ *********************************************/
+JobSystem & JobSystem::shared()
+{
+   static JobSystem jobs;
+   return jobs;
+}
+
+/*********************************************
+ * JOB SYSTEM : PARALLEL FOR
+ * Deal the chunks out to the queues, then work alongside
+ * the workers until the last chunk is finished
+ *********************************************/
+void JobSystem::parallelFor(size_t count, size_t grain,
+                            const function<void(size_t, size_t)> & f)
+{
+   assert(grain > 0);
+   size_t chunks = numChunks(count, grain);
+
+   // not worth waking anybody up
+   if (chunks <= 1 || workers.empty() || isWorkerThread)
+   {
+      for (size_t begin = 0; begin < count; begin += grain)
+         f(begin, min(count, begin + grain));
+      return;
+   }
+
+   // counted before they are queued, so a worker that takes one
+   // never brings numPending below zero
+   {
+      lock_guard<mutex> guard(sleepLock);
+      numPending += chunks;
+   }
+   atomic<size_t> remaining(chunks);
+   for (size_t k = 0; k < chunks; k++)
+   {
+      Queue & queue = *queues[k % queues.size()];
+      lock_guard<mutex> guard(queue.lock);
+      queue.jobs.push_back({ &f, k * grain, min(count, (k + 1) * grain), &remaining });
+   }
+   wakeUp.notify_all();
+
+   // help out until everything is done. A chunk is a few microseconds,
+   // less than it takes to sleep and be woken, so we only yield
+   Job job;
+   while (remaining.load(memory_order_acquire) > 0)
+      if (pop(0, job) || steal(0, job))
+         run(job);
+      else
+         this_thread::yield();
+}
+
+/*********************************************
+ * JOB SYSTEM : POP
+ * Take the most recent job from our own queue
+ *********************************************/
+bool JobSystem::pop(size_t index, Job & job)
+{
+   Queue & queue = *queues[index];
+   lock_guard<mutex> guard(queue.lock);
+   if (queue.jobs.empty())
+      return false;
+   job = queue.jobs.back();
+   queue.jobs.pop_back();
+   numPending--;
+   return true;
+}
+
+/*********************************************
+ * JOB SYSTEM : STEAL
+ * Take the oldest job from somebody else's queue
+ *********************************************/
+bool JobSystem::steal(size_t index, Job & job)
+{
+   for (size_t i = 1; i < queues.size(); i++)
+   {
+      Queue & queue = *queues[(index + i) % queues.size()];
+      lock_guard<mutex> guard(queue.lock);
+      if (!queue.jobs.empty())
+      {
+         job = queue.jobs.front();
+         queue.jobs.pop_front();
+         numPending--;
+         return true;
+      }
+   }
+   return false;
+}
+
+/*********************************************
+ * JOB SYSTEM : RUN
+ * Do one chunk and check it off
+ *********************************************/
+void JobSystem::run(const Job & job)
+{
+   (*job.pFunction)(job.begin, job.end);
+   job.pRemaining->fetch_sub(1, memory_order_release);
+}
+
+/*********************************************
+ * JOB SYSTEM : WORK
+ * What a worker thread does until the pool goes away
+ *********************************************/
+void JobSystem::work(size_t index)
+{
+   isWorkerThread = true;
+   Job job;
+   for (;;)
+   {
+      if (pop(index, job) || steal(index, job))
+      {
+         run(job);
+         continue;
+      }
+
+      // nothing to do: sleep until there is
+      unique_lock<mutex> guard(sleepLock);
+      wakeUp.wait(guard, [this] { return isDone || numPending > 0; });
+      if (isDone)
+         return;
+   }
+}
@@ -0,0 +1,80 @@
+/***********************************************************************
+ * Header File:
+ *    JOB SYSTEM : Spread a loop across every core
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    A pool of worker threads, each with its own queue of jobs. A worker
+ *    takes from the back of its own queue and, when that runs dry, steals
+ *    from the front of someone else's. parallelFor() cuts a range into
+ *    chunks, deals them out, and helps with the work until it is done.
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*********************************************
+ * JOB SYSTEM
+ * A work-stealing thread pool
+ *********************************************/
+class JobSystem
+{
+public:
+   // numThreads counts the calling thread. 0 means one per core.
+   JobSystem(unsigned int numThreads = 0);
+   ~JobSystem();
+
+   // one shared by the whole program, one thread per core
+   static JobSystem & shared();
+
+   // how many threads, including the one that calls parallelFor()?
+   unsigned int size() const { return (unsigned int)workers.size() + 1; }
+
+   // call f(begin, end) for each chunk of [0, count). Chunk k covers
+   // [k * grain, (k + 1) * grain), so begin / grain is the chunk number.
+   // Returns when every chunk is done.
+   void parallelFor(size_t count, size_t grain,
+                    const std::function<void(size_t, size_t)> & f);
+
+   // how many chunks parallelFor() will cut a range into
+   static size_t numChunks(size_t count, size_t grain)
+   {
+      return (count + grain - 1) / grain;
+   }
+
+private:
+   struct Job
+   {
+      const std::function<void(size_t, size_t)> * pFunction;
+      size_t begin;
+      size_t end;
+      std::atomic<size_t> * pRemaining;   // chunks of this loop not yet done
+   };
+
+   struct Queue
+   {
+      std::mutex lock;
+      std::deque<Job> jobs;
+   };
+
+   bool pop(size_t index, Job & job);       // from the back of our own queue
+   bool steal(size_t index, Job & job);     // from the front of another
+   void run(const Job & job);
+   void work(size_t index);                 // a worker thread's life
+
+   std::vector<std::unique_ptr<Queue>> queues;   // [0] belongs to the caller
+   std::vector<std::thread> workers;             // worker i owns queues[i + 1]
+   std::mutex sleepLock;
+   std::condition_variable wakeUp;
+   std::atomic<size_t> numPending;               // jobs queued, all loops
+   bool isDone;
+};
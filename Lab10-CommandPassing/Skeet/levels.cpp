@@ -0,0 +1,137 @@
+/***********************************************************************
+ * Source File:
+ *    LEVELS : How long each level is and which birds it sends up
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Reading and writing a level table as text
+ ************************************************************************/
+
+#include "levels.h"
+#include <sstream>
+#include <string>
+using namespace std;
+
+// what each kind of bird is called in the file
+static const char * KIND_NAMES[SpawnRule::NUM_KINDS] =
+{
+   "standard", "floater", "sinker", "crazy"
+};
+
+// the longest level, the biggest and fastest bird, and the rarest one,
+// that make sense. A wait rolled for the rarest is still far from INT_MAX
+const int    MAX_SECONDS = 60 * 60;
+const double MAX_RADIUS  = 100.0;
+const double MAX_SPEED   = 50.0;
+const int    MAX_ONE_IN  = MAX_SECONDS * 30;     // once an hour, in frames
+
+/*********************************************
+ * IS PLAYABLE
+ * Written so a NaN fails every comparison
+ *********************************************/
+bool isPlayable(const LevelTable & table)
+{
+   if (table[0].numSpawns != 0)
+      return false;
+
+   for (int level = 1; level <= NUM_LEVELS; level++)
+   {
+      const LevelRule & rule = table[level];
+      if (!(rule.seconds > STATUS_SECONDS && rule.seconds <= MAX_SECONDS) ||
+          rule.numSpawns < 0 || rule.numSpawns > MAX_SPAWN_RULES)
+         return false;
+
+      for (int i = 0; i < rule.numSpawns; i++)
+      {
+         const SpawnRule & spawn = rule.spawns[i];
+         if (spawn.kind < 0 || spawn.kind >= SpawnRule::NUM_KINDS ||
+             !(spawn.radius > 1.0 && spawn.radius <= MAX_RADIUS) ||   // drawDisk()
+             !(spawn.speed  > 0.0 && spawn.speed  <= MAX_SPEED)  ||
+             spawn.oneIn < 1 || spawn.oneIn > MAX_ONE_IN)
+            return false;
+      }
+   }
+   return true;
+}
+
+/*********************************************
+ * READ LEVELS
+ * Every level line and the spawn lines under it. The
+ * whole file is checked before the table is changed.
+ *********************************************/
+bool readLevels(istream & in, LevelTable & table)
+{
+   LevelTable read = {};
+   LevelRule * pLevel = nullptr;
+   string line;
+   while (getline(in, line))
+   {
+      istringstream sin(line);
+      string word;
+      if (!(sin >> word) || word[0] == '#')
+         continue;
+
+      if (word == "level")
+      {
+         int number;
+         if (!(sin >> number) || number < 1 || number > NUM_LEVELS)
+            return false;
+         pLevel = &read[number];
+         if (!(sin >> pLevel->seconds) || pLevel->seconds <= 0)
+            return false;
+         pLevel->numSpawns = 0;
+      }
+      else if (word == "spawn")
+      {
+         if (!pLevel || pLevel->numSpawns == MAX_SPAWN_RULES)
+            return false;
+         SpawnRule & rule = pLevel->spawns[pLevel->numSpawns++];
+
+         string kind;
+         if (!(sin >> kind >> rule.radius >> rule.speed >> rule.points >> rule.oneIn) ||
+             rule.oneIn < 1)
+            return false;
+         rule.kind = SpawnRule::NUM_KINDS;
+         for (int i = 0; i < SpawnRule::NUM_KINDS; i++)
+            if (kind == KIND_NAMES[i])
+               rule.kind = i;
+         if (rule.kind == SpawnRule::NUM_KINDS)
+            return false;
+
+         string empty;
+         rule.isWhenEmpty = (sin >> empty) && empty == "empty";
+      }
+      else
+         return false;
+   }
+
+   // every level has to be there, and be one the game can play
+   if (!isPlayable(read))
+      return false;
+
+   table = read;
+   return true;
+}
+
+/*********************************************
+ * WRITE LEVELS
+ * The table in the form readLevels() takes
+ *********************************************/
+void writeLevels(ostream & out, const LevelTable & table)
+{
+   out << "# level <number> <seconds>\n"
+       << "# spawn <kind> <radius> <speed> <points> <oneIn> [empty]\n";
+   for (int level = 1; level <= NUM_LEVELS; level++)
+   {
+      const LevelRule & rule = table[level];
+      out << "level " << level << ' ' << rule.seconds << '\n';
+      for (int i = 0; i < rule.numSpawns; i++)
+      {
+         const SpawnRule & spawn = rule.spawns[i];
+         out << "spawn " << KIND_NAMES[spawn.kind] << ' '
+             << spawn.radius << ' ' << spawn.speed << ' '
+             << spawn.points << ' ' << spawn.oneIn
+             << (spawn.isWhenEmpty ? " empty" : "") << '\n';
+      }
+   }
+}
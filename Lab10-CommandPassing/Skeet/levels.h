@@ -0,0 +1,114 @@
+/***********************************************************************
+ * Header File:
+ *    LEVELS : How long each level is and which birds it sends up
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Every level is described by a row of a table: how many seconds it
+ *    lasts, and a list of rules for spawning birds. A rule names the
+ *    kind of bird, its radius, speed, and points, and how often it comes
+ *    up. The table the game ships with is a constexpr, so each level's
+ *    rules are turned into straight-line code when the game is built.
+ *    A table of the same shape can also be read from a file, for trying
+ *    out new numbers without building again:
+ *
+ *       level <number> <seconds>
+ *       spawn <kind> <radius> <speed> <points> <oneIn> [empty]
+ *
+ *    Each spawn line belongs to the level line above it. "empty" means
+ *    the rule is only tried when there are no birds on the screen. Lines
+ *    starting with # are ignored. See levels.txt for the shipped table.
+ ************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <istream>
+#include <ostream>
+
+// levels 1 through NUM_LEVELS are played; level 0 is the game being over
+const int NUM_LEVELS = 4;
+
+// the most spawn rules one level can have
+const int MAX_SPAWN_RULES = 5;
+
+// every level starts with this many seconds of the status screen
+const int STATUS_SECONDS = 5;
+
+/*********************************************
+ * SPAWN RULE
+ * One kind of bird that turns up in a level
+ *********************************************/
+struct SpawnRule
+{
+   // in the same order as the birds' roster
+   enum Kind { STANDARD, FLOATER, SINKER, CRAZY, NUM_KINDS };
+
+   int kind;
+   double radius;
+   double speed;
+   int points;
+   int oneIn;           // comes up about once in this many frames ...
+   bool isWhenEmpty;    // ... but only when there are no birds, if set
+};
+
+/*********************************************
+ * LEVEL RULE
+ * How long a level is and what birds it has. The spawn
+ * rules are tried in order every frame of the level.
+ *********************************************/
+struct LevelRule
+{
+   int seconds;         // including the status screen at the start
+   int numSpawns;
+   SpawnRule spawns[MAX_SPAWN_RULES];
+};
+
+// every level, and the game being over in [0]
+typedef std::array<LevelRule, NUM_LEVELS + 1> LevelTable;
+
+/*********************************************
+ * LEVELS
+ * The levels the game ships with
+ *********************************************/
+constexpr LevelTable LEVELS =
+{ {
+   // game over
+   { 0, 0, {} },
+
+   // big birds occasionally
+   { 30, 2, {
+      { SpawnRule::STANDARD, 30.0, 7.0, 10, 15,     true  },
+      { SpawnRule::STANDARD, 30.0, 7.0, 10, 4 * 30, false } } },
+
+   // two kinds of birds
+   { 30, 3, {
+      { SpawnRule::STANDARD, 25.0, 7.0, 12, 15,     true  },
+      { SpawnRule::STANDARD, 25.0, 5.0, 12, 4 * 30, false },
+      { SpawnRule::SINKER,   25.0, 4.5, 20, 3 * 30, false } } },
+
+   // three kinds of birds
+   { 45, 4, {
+      { SpawnRule::STANDARD, 20.0, 5.0, 15, 15,     true  },
+      { SpawnRule::STANDARD, 20.0, 5.0, 15, 4 * 30, false },
+      { SpawnRule::SINKER,   20.0, 4.0, 22, 4 * 30, false },
+      { SpawnRule::FLOATER,  20.0, 5.0, 15, 4 * 30, false } } },
+
+   // four kinds of small birds
+   { 45, 5, {
+      { SpawnRule::STANDARD, 15.0, 4.0, 18, 15,     true  },
+      { SpawnRule::STANDARD, 15.0, 4.0, 18, 4 * 30, false },
+      { SpawnRule::SINKER,   15.0, 3.5, 25, 4 * 30, false },
+      { SpawnRule::FLOATER,  15.0, 4.0, 25, 4 * 30, false },
+      { SpawnRule::CRAZY,    15.0, 4.5, 30, 4 * 30, false } } }
+} };
+
+// can every level of the table be played? Each has to outlast its
+// status screen and send up birds that can be drawn and that cross
+// the screen, and level 0 sends up none
+bool isPlayable(const LevelTable & table);
+
+// read a table in the format above, or write one out. Reading leaves
+// the table alone and returns false if anything is wrong with the file
+bool readLevels(std::istream & in, LevelTable & table);
+void writeLevels(std::ostream & out, const LevelTable & table);
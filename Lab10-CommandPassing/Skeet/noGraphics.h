@@ -0,0 +1,48 @@
+/***********************************************************************
+ * Header File:
+ *    NO GRAPHICS : OpenGL and GLUT calls that do nothing
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Compile with NO_GRAPHICS defined and every source file that draws
+ *    includes this instead of the OpenGL and GLUT headers. The drawing
+ *    code still compiles but does nothing, and the program links without
+ *    either library. This is how the game logic is built for the batched
+ *    environment, which never opens a window.
+ ************************************************************************/
+
+#pragma once
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+typedef float GLfloat;
+typedef unsigned int GLenum;
+
+enum : GLenum
+{
+   GL_LINES        = 0x0001,
+   GL_LINE_STRIP   = 0x0003,
+   GL_TRIANGLES    = 0x0004,
+   GL_TRIANGLE_FAN = 0x0006,
+   GL_QUADS        = 0x0007
+};
+
+// the special keys, as GLUT numbers them
+enum
+{
+   GLUT_KEY_LEFT   = 100,
+   GLUT_KEY_UP     = 101,
+   GLUT_KEY_RIGHT  = 102,
+   GLUT_KEY_DOWN   = 103,
+   GLUT_KEY_HOME   = 106
+};
+
+#define GLUT_TEXT nullptr
+
+inline void glBegin(GLenum)                       {}
+inline void glEnd()                               {}
+inline void glColor3f(GLfloat, GLfloat, GLfloat)  {}
+inline void glVertex2f(GLfloat, GLfloat)          {}
+inline void glRasterPos2f(GLfloat, GLfloat)       {}
+inline void glutBitmapCharacter(void *, int)      {}
@@ -0,0 +1,189 @@
+/***********************************************************************
+ * Source File:
+ *    PIPELINE : Simulate on one thread, draw on another
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    The simulation runs on its own thread at a steady 30 frames a
+ *    second. After each frame it publishes a snapshot of the game into
+ *    a triple buffer. The GLUT thread pushes the player's key events into
+ *    a lock-free queue, which the simulation drains every frame, and
+ *    draws whatever snapshot is newest. A slow draw never holds up the
+ *    physics, and a slow physics frame never holds up the screen.
+ ************************************************************************/
+
+#include "pipeline.h"
+#include <algorithm>
+#include <sstream>
+using namespace std;
+using namespace std::chrono;
+
+/*********************************************
+ * PIPELINE constructor
+ *********************************************/
+Pipeline::Pipeline(Skeet & skeet, CommandWriter * pRecorder) :
+   skeet(skeet), pRecorder(pRecorder), pAutopilot(nullptr), pWatcher(nullptr), isRunning(false),
+   numSteps(0), secondsStepping(0.0), worstStep(0.0), numLateSteps(0),
+   numDraws(0), numRepeats(0), numSkipped(0),
+   secondsLatency(0.0), worstLatency(0.0), lastFrame(0),
+   numInputs(0), secondsInput(0.0), worstInput(0.0)
+{
+}
+
+/*********************************************
+ * PIPELINE : START
+ * Publish the game as it is now, then set the simulation going
+ *********************************************/
+void Pipeline::start()
+{
+   if (isRunning)
+      return;
+   skeet.publish(snapshots.back());
+   snapshots.back().published = steady_clock::now();
+   snapshots.publish();
+
+   isRunning = true;
+   simulation = thread(&Pipeline::simulate, this);
+}
+
+/*********************************************
+ * PIPELINE : STOP
+ * Let the simulation finish the frame it is on
+ *********************************************/
+void Pipeline::stop()
+{
+   isRunning = false;
+   if (simulation.joinable())
+      simulation.join();
+}
+
+/*********************************************
+ * PIPELINE : ACQUIRE
+ * The newest snapshot, how long it waited to be drawn, and how
+ * long ago the keys it responds to were pressed
+ *********************************************/
+const Snapshot & Pipeline::acquire()
+{
+   bool isNew = snapshots.update();
+   const Snapshot & snapshot = snapshots.front();
+   steady_clock::time_point now = steady_clock::now();
+
+   if (numDraws == 0)
+      firstDraw = now;
+   else if (!isNew)
+      numRepeats++;
+   else if (snapshot.frame > lastFrame + 1)
+      numSkipped += snapshot.frame - lastFrame - 1;
+   lastFrame = snapshot.frame;
+   numDraws++;
+
+   double latency = duration<double>(now - snapshot.published).count();
+   secondsLatency += latency;
+   worstLatency = max(worstLatency, latency);
+
+   if (isNew && snapshot.hasInput)
+   {
+      double seconds = duration<double>(now - snapshot.input).count();
+      numInputs++;
+      secondsInput += seconds;
+      worstInput = max(worstInput, seconds);
+   }
+
+   return snapshot;
+}
+
+/*********************************************
+ * PIPELINE : SIMULATE
+ * Run a frame every 1/30th of a second until told to stop. A
+ * frame that runs long is not made up for by rushing the next.
+ *********************************************/
+void Pipeline::simulate()
+{
+   const steady_clock::duration tick =
+      duration_cast<steady_clock::duration>(duration<double>(1.0 / FRAMES_PER_SECOND));
+   steady_clock::time_point next = steady_clock::now();
+   vector<Command> commands;
+   vector<Command> pilot;
+
+   while (isRunning)
+   {
+      next += tick;
+
+      // new numbers, if the designer saved some, go in between frames
+      if (pWatcher)
+         if (shared_ptr<const Tuning> pTuning = pWatcher->take())
+            skeet.setTuning(pTuning);
+
+      // whatever the player asked for since the last frame, without a lock
+      KeyEvent event;
+      while (events.pop(event))
+         keyboard.apply(event);
+      commands = keyboard.translate(skeet.getFrame());
+      if (pAutopilot)
+      {
+         pAutopilot->decide(skeet, pilot);
+         commands.insert(commands.end(), pilot.begin(), pilot.end());
+      }
+      if (pRecorder)
+         pRecorder->write(commands);
+
+      // one frame of the game, handed over to be drawn
+      steady_clock::time_point start = steady_clock::now();
+      skeet.execute(commands);
+      skeet.animate();
+      Snapshot & snapshot = snapshots.back();
+      skeet.publish(snapshot);
+      snapshot.hasInput = keyboard.takeEarliest(snapshot.input);
+      snapshot.published = steady_clock::now();
+      snapshots.publish();
+
+      double seconds = duration<double>(snapshot.published - start).count();
+      numSteps++;
+      secondsStepping = secondsStepping + seconds;
+      worstStep = max(worstStep.load(), seconds);
+
+      // wait for the next frame, or start it now if we are late
+      if (snapshot.published > next)
+      {
+         numLateSteps++;
+         next = snapshot.published;
+      }
+      else
+         this_thread::sleep_until(next);
+   }
+}
+
+/*********************************************
+ * PIPELINE : REPORT
+ * Simulation throughput and presentation latency
+ *********************************************/
+string Pipeline::report() const
+{
+   ostringstream sout;
+   unsigned long long steps = numSteps;
+   sout << "simulation:   " << steps << " frames, "
+        << (steps ? secondsStepping / steps * 1000.0 : 0.0) << " ms average, "
+        << worstStep * 1000.0 << " ms worst, "
+        << numLateSteps << " late\n";
+
+   double seconds = numDraws ?
+      duration<double>(steady_clock::now() - firstDraw).count() : 0.0;
+   sout << "presentation: " << numDraws << " draws, "
+        << (seconds > 0.0 ? numDraws / seconds : 0.0) << " per second, "
+        << (numDraws ? secondsLatency / numDraws * 1000.0 : 0.0) << " ms average latency, "
+        << worstLatency * 1000.0 << " ms worst, "
+        << numRepeats << " repeated, " << numSkipped << " skipped\n";
+   sout << "input:        " << numInputs << " frames with key events, "
+        << (numInputs ? secondsInput / numInputs * 1000.0 : 0.0) << " ms average to the screen, "
+        << worstInput * 1000.0 << " ms worst, "
+        << events.getDropped() << " events dropped\n";
+   sout << "arena:       ";
+   for (int level = 1; level < skeet.getArenaLevels(); level++)
+      sout << " level " << level << " " << skeet.getArenaPeak(level) / 1024.0 << " KB peak";
+   sout << "\n";
+   if (pAutopilot)
+      sout << "autopilot:    " << pAutopilot->getSolves() << " aim solves, "
+           << pAutopilot->getSecondsSolving() * 1000.0 << " ms, "
+           << pAutopilot->getSolvesPerSecond() << " per second\n";
+   return sout.str();
+}
@@ -0,0 +1,93 @@
+/***********************************************************************
+ * Header File:
+ *    PIPELINE : Simulate on one thread, draw on another
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    The simulation runs on its own thread at a steady 30 frames a
+ *    second. After each frame it publishes a snapshot of the game into
+ *    a triple buffer. The GLUT thread pushes the player's key events into
+ *    a lock-free queue, which the simulation drains every frame, and
+ *    draws whatever snapshot is newest. A slow draw never holds up the
+ *    physics, and a slow physics frame never holds up the screen.
+ ************************************************************************/
+
+#pragma once
+
+#include "skeet.h"
+#include "snapshot.h"
+#include "tripleBuffer.h"
+#include "command.h"
+#include "eventQueue.h"
+#include "autopilot.h"
+#include "tuning.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*********************************************
+ * PIPELINE
+ * A simulation thread feeding a render thread
+ *********************************************/
+class Pipeline
+{
+public:
+   // every command is written to pRecorder, if there is one, before it is run
+   Pipeline(Skeet & skeet, CommandWriter * pRecorder = nullptr);
+   ~Pipeline() { stop(); }
+
+   // start and stop the simulation thread. stop() may be called twice.
+   void start();
+   void stop();
+
+   // GLUT thread: where the key callbacks send their events
+   KeyEventQueue & getEvents() { return events; }
+
+   // before start(): let the autopilot play alongside the keyboard
+   void setAutopilot(Autopilot * pAutopilot) { this->pAutopilot = pAutopilot; }
+
+   // before start(): play on with each new tuning the watcher finds. A
+   // recording made while the numbers change will not replay the same
+   void setTuning(TuningWatcher * pWatcher) { this->pWatcher = pWatcher; }
+
+   // render thread: the newest snapshot there is
+   const Snapshot & acquire();
+
+   // how each side has done so far, one line each
+   std::string report() const;
+
+private:
+   void simulate();                  // the simulation thread's life
+
+   Skeet & skeet;
+   CommandWriter * pRecorder;
+   Autopilot * pAutopilot;
+   TuningWatcher * pWatcher;
+   TripleBuffer<Snapshot> snapshots;
+
+   KeyEventQueue events;             // key presses, oldest first
+   Keyboard keyboard;                // the keys, as of the last frame
+
+   std::thread simulation;
+   std::atomic<bool> isRunning;
+
+   // simulation side: written by the simulation thread
+   std::atomic<unsigned long long> numSteps;
+   std::atomic<double> secondsStepping;     // execute, animate, and publish
+   std::atomic<double> worstStep;
+   std::atomic<unsigned int> numLateSteps;  // took longer than a frame
+
+   // presentation side: written by the render thread
+   unsigned long long numDraws;
+   unsigned long long numRepeats;           // same snapshot drawn again
+   unsigned long long numSkipped;           // snapshots never drawn
+   double secondsLatency;                   // published until drawn
+   double worstLatency;
+   unsigned int lastFrame;
+   unsigned long long numInputs;            // frames drawn that took key events
+   double secondsInput;                     // key event until drawn
+   double worstInput;
+   std::chrono::steady_clock::time_point firstDraw;
+};
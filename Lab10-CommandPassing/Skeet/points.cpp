@@ -8,8 +8,13 @@
  ************************************************************************/
 
  #include "points.h"
+ #include "dice.h"
  #include <cassert>
 
+#ifdef NO_GRAPHICS
+#include "noGraphics.h"  // draw nothing: no OpenGL, no GLUT
+#else // !NO_GRAPHICS
+
 #ifdef __APPLE__
 #define GL_SILENCE_DEPRECATION
 #include <openGL/gl.h>    // Main OpenGL library
@@ -31,6 +36,10 @@
 #include <math.h>
 #define GLUT_TEXT GLUT_BITMAP_HELVETICA_12
 #endif // _WIN32
+#endif // NO_GRAPHICS
+
+// age lost each frame
+const double FADE = 0.01;
 
  /******************************************************************
  * RANDOM
@@ -39,7 +48,7 @@
 double randomValue(double min, double max)
 {
    assert(min <= max);
-   double num = min + ((double)rand() / (double)RAND_MAX * (max - min));
+   double num = min + ((double)roll() / (double)RAND_MAX * (max - min));
    assert(min <= num && num <= max);
    return num;
 }
@@ -104,5 +113,17 @@ void Points::update()
    v.addDx(randomValue(-0.15, 0.15));
    v.addDy(randomValue(-0.15, 0.15));
    pt += v;
-   age -= 0.01;
+   age -= FADE;
+}
+
+/************************************************************************
+ * GET LIFETIME
+ * Count down exactly as update() does, so the answer is exact
+ *************************************************************************/
+int Points::getLifetime() const
+{
+   int frames = 0;
+   for (float a = age; a > 0.0; a -= FADE)
+      frames++;
+   return frames;
 }
\ No newline at end of file
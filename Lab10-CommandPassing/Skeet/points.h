@@ -23,6 +23,9 @@ public:
    void show() const;
    void update();
    bool isDead() const {return age <= 0.0; }
+   int getLifetime() const;   // calls to update() until it is dead
+   Position getPosition() const { return pt; }
+   int getValue() const { return value; }
 private:
    Position pt;
    Velocity v;
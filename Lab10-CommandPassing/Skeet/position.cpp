@@ -11,41 +11,6 @@
 #include <cmath>
 #include <cassert>
 
-/******************************************
- * POINT : CONSTRUCTOR WITH X,Y
- * Initialize the point to the passed position
- *****************************************/
-Position::Position(double x, double y) : x(0.0), y(0.0)
-{
-   setX(x);
-   setY(y);
-}
-
-/******************************************
- * POINT : ADD
- * Move a point according to a velocity
- *****************************************/
-void Position::add(const Velocity & v)
-{
-    *this += v;
-}
-Position & Position :: operator += (const Velocity & v)
-{
-    addX(v.getDx());
-    addY(v.getDy());
-    return *this;
-}
-
-/******************************************
- * VELOCITY : CONSTRUCTOR WITH X,Y
- * Initialize the point to the passed position
- *****************************************/
-Velocity::Velocity(double dx, double dy) : dx(0.0), dy(0.0)
-{
-   setDx(dx);
-   setDy(dy);
-}
-
 /******************************************
  * POINT insertion
  *       Display coordinates on the screen
@@ -75,8 +40,10 @@ std::istream & operator >> (std::istream & in, Position & pt)
 double minimumDistance(const Position & pt1, const Velocity & v1,
                        const Position & pt2, const Velocity & v2) 
 {
-   double d1 = max(abs(v1.getDx()), abs(v1.getDy()));
-   double d2 = max(abs(v2.getDx()), abs(v2.getDy()));
+   // whole pixels per frame: this has always been the int abs(), and
+   // every recorded game depends on where the slices fall
+   double d1 = max(abs((int)v1.getDx()), abs((int)v1.getDy()));
+   double d2 = max(abs((int)v2.getDx()), abs((int)v2.getDy()));
    double dMax = max(d1, d2);
    assert(dMax > 0.0);
 
@@ -90,16 +57,12 @@ double minimumDistance(const Position & pt1, const Velocity & v1,
    for (double percent = 0.0; percent <= 1.0; percent += slice)
    {
       // find the points of the LHS and the RHS
-      Position pointLhs(pt1.getX() + (v1.getDx() * percent),
-                     pt1.getY() + (v1.getDy() * percent));
-      Position pointRhs(pt2.getX() + (v2.getDx() * percent),
-                     pt2.getY() + (v2.getDy() * percent));
+      Vec2d pointLhs = widen(pt1.getVec2()) + widen(v1.getVec2()) * percent;
+      Vec2d pointRhs = widen(pt2.getVec2()) + widen(v2.getVec2()) * percent;
 
       // how far apart are they now?
-      double distSquared =
-         ((pointLhs.getX() - pointRhs.getX()) * (pointLhs.getX() - pointRhs.getX())) +
-         ((pointLhs.getY() - pointRhs.getY()) * (pointLhs.getY() - pointRhs.getY()));
-      distMin = min(distMin, distSquared);
+      Vec2d gap = pointLhs - pointRhs;
+      distMin = min(distMin, dot(gap, gap));
    }
 
    return sqrt(distMin);
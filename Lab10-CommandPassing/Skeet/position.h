@@ -12,128 +12,156 @@
 
 #include <iostream>
 #include <cmath>
+#include <type_traits>
+#include "vec2.h"
 
 class Velocity;
 
 /*********************************************
  * POINT
- * A single position.  
+ * A single position. A thin wrapper over Vec2,
+ * so it copies like one and lines up in arrays.
  *********************************************/
 class Position
 {
 public:
    // constructors
-   Position()            : x(0.0), y(0.0)  {}
-   Position(double x, double y);
-   Position(const Position & pt) : x(pt.x), y(pt.y) {}
+   Position()                     : v{ 0.0, 0.0 }           {}
+   Position(double x, double y)   : v{ (Real)x, (Real)y }   {}
+   explicit Position(const Vec2 & v) : v(v)       {}
 
    // getters
-   double getX()       const { return x;              }
-   double getY()       const { return y;              }
+   double getX()       const { return v.x;            }
+   double getY()       const { return v.y;            }
+   const Vec2 & getVec2() const { return v;           }
    bool operator == (const Position & rhs) const
    {
-      return x == rhs.x && y == rhs.y;
+      return v.x == rhs.v.x && v.y == rhs.v.y;
    }
    bool operator != (const Position & rhs) const
    {
-      return x != rhs.x || y != rhs.y;
+      return v.x != rhs.v.x || v.y != rhs.v.y;
    }
 
    // setters
-   void setX(double x)       { this->x = x;           }
-   void setY(double y)       { this->y = y;           }
-   void addX(double dx)      { setX(getX() + dx);     }
-   void addY(double dy)      { setY(getY() + dy);     }
-   void add(const Velocity & v);
-   Position & operator += (const Velocity & v);
-   Position & operator = (const Position & rhs)
-   {
-      x = rhs.x;
-      y = rhs.y;
-      return *this;
-   }
+   void setX(double x)       { v.x = (Real)x;         }
+   void setY(double y)       { v.y = (Real)y;         }
+   void addX(double dx)      { v.x += (Real)dx;       }
+   void addY(double dy)      { v.y += (Real)dy;       }
+   void add(const Velocity & vel);
+   Position & operator += (const Velocity & vel);
+
+private:
+   Vec2 v;             // horizontal and vertical position
+};
+
+/*********************************************
+ * ROTATION
+ * A turn by a fixed angle, counted the way Velocity
+ * counts direction: clockwise from straight up. The
+ * sine and cosine are worked out once, when it is made.
+ *********************************************/
+class Rotation
+{
+public:
+   explicit Rotation(double radians) : cosine(cos(radians)), sine(sin(radians)) {}
+   double getCos() const { return cosine; }
+   double getSin() const { return sine;   }
 
 private:
-   double x;           // horizontal position
-   double y;           // vertical position
+   double cosine;
+   double sine;
 };
 
 /*********************************************
  * VELOCITY
- * Movement
+ * Movement, also a thin wrapper over Vec2
  *********************************************/
 class Velocity
 {
 public:
    // constructors
-   Velocity()            : dx(0.0), dy(0.0)  {}
-   Velocity(double dx, double dy);
-   Velocity(const Velocity & v) : dx(v.dx), dy(v.dy) {}
+   Velocity()                     : v{ 0.0, 0.0 }           {}
+   Velocity(double dx, double dy) : v{ (Real)dx, (Real)dy } {}
+   explicit Velocity(const Vec2 & v) : v(v)       {}
 
    // getters
-   double getDx()       const { return dx;              }
-   double getDy()       const { return dy;              }
+   double getDx()       const { return v.x;             }
+   double getDy()       const { return v.y;             }
+   const Vec2 & getVec2() const { return v;             }
    bool operator == (const Velocity & rhs) const
    {
-      return dx == rhs.dx && dy == rhs.dy;
+      return v.x == rhs.v.x && v.y == rhs.v.y;
    }
    bool operator != (const Velocity & rhs) const
    {
-      return dx != rhs.dx || dy != rhs.dy;
+      return v.x != rhs.v.x || v.y != rhs.v.y;
    }
    double getSpeed() const
    {
-      return sqrt(dx * dx + dy * dy);
+      return length(widen(v));
    }
 
    // setters
-   void setDx(double dx)       { this->dx = dx;   }
-   void setDy(double dy)       { this->dy = dy;   }
-   void addDx(double dx)       { this->dx += dx;  }
-   void addDy(double dy)       { this->dy += dy;  }
-   Velocity & operator += (const Velocity & v)
+   void setDx(double dx)       { v.x = (Real)dx;   }
+   void setDy(double dy)       { v.y = (Real)dy;   }
+   void addDx(double dx)       { v.x += (Real)dx;  }
+   void addDy(double dy)       { v.y += (Real)dy;  }
+   Velocity & operator += (const Velocity & rhs)
    {
-      addDx(v.getDx());
-      addDy(v.getDy());
+      v += rhs.v;
       return *this;
    }
-   void add(const Velocity & v)
+   void add(const Velocity & rhs)
    {
-      *this += v;
-   }
-   Velocity & operator = (const Velocity & rhs)
-   {
-      dx = rhs.dx;
-      dy = rhs.dy;
-      return *this;
+      *this += rhs;
    }
    Velocity & operator *= (double mult)
    {
-      dx *= mult;
-      dy *= mult;
+      v *= (Real)mult;
       return *this;
    }
-   Velocity operator* (double mult)
+   Velocity operator* (double mult) const
    {
-      Velocity v(*this);
-      v *= mult;
-      return v;
+      return Velocity(v * (Real)mult);
    }
    void set(double angle, double speed)
    {
-      dx = sin(angle) * speed;
-      dy = cos(angle) * speed;
+      v.x = (Real)(sin(angle) * speed);
+      v.y = (Real)(cos(angle) * speed);
+   }
+   void turn(const Rotation & rotation)
+   {
+      // clockwise is the other way around from Vec2's rotate()
+      v = rotate(v, (Real)rotation.getCos(), (Real)-rotation.getSin());
    }
    void turn(double radians = 0.04)
    {
-      set(atan2(dx, dy) + radians, getSpeed());      
+      turn(Rotation(radians));
    }
 
 private:
-   double dx;           // horizontal velocity
-   double dy;           // vertical velocity
+   Vec2 v;             // horizontal and vertical velocity
 };
 
+/******************************************
+ * POINT : ADD
+ * Move a point according to a velocity
+ *****************************************/
+inline void Position::add(const Velocity & vel)
+{
+   *this += vel;
+}
+inline Position & Position :: operator += (const Velocity & vel)
+{
+   v += vel.getVec2();
+   return *this;
+}
+
+// both copy with memcpy, so arrays of them can be moved and batched freely
+static_assert(std::is_trivially_copyable<Position>::value, "Position must stay plain");
+static_assert(std::is_trivially_copyable<Velocity>::value, "Velocity must stay plain");
+
 // stream I/O useful for debugging
 std::ostream & operator << (std::ostream & out, const Position & pt);
 std::istream & operator >> (std::istream & in,        Position & pt);
@@ -0,0 +1,136 @@
+/***********************************************************************
+ * Header File:
+ *    ROSTER : One container per kind of thing
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Instead of one list of pointers to a base class, a roster keeps the
+ *    objects themselves in a separate vector for each kind. A loop over
+ *    the roster is really one loop per kind, so the compiler knows the
+ *    exact type of every object and can inline the work into the loop.
+ ************************************************************************/
+
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <cstddef>
+
+/*********************************************
+ * ROSTER
+ * A vector for each of the listed kinds
+ *********************************************/
+template <class ... Kinds>
+class Roster
+{
+public:
+   // how many kinds there are
+   static const size_t NUM_KINDS = sizeof...(Kinds);
+
+   // add one thing to the end of the vector for its kind
+   template <class T>
+   void add(const T & t) { get<T>().push_back(t); }
+
+   // all the things of one kind
+   template <class T>
+   std::vector<T> & get() { return std::get<std::vector<T>>(kinds); }
+   template <class T>
+   const std::vector<T> & get() const { return std::get<std::vector<T>>(kinds); }
+
+   // visit everything, one kind at a time, in the order the kinds are listed
+   template <class F>
+   void forEach(F f)
+   {
+      std::apply([&f](auto & ... v) { (visit(v, f), ...); }, kinds);
+   }
+   template <class F>
+   void forEach(F f) const
+   {
+      std::apply([&f](const auto & ... v) { (visit(v, f), ...); }, kinds);
+   }
+
+   // visit the whole vector of each kind, for work that wants the entire range
+   template <class F>
+   void forEachKind(F f)
+   {
+      std::apply([&f](auto & ... v) { (f(v), ...); }, kinds);
+   }
+
+   // visit the whole vector of one kind, by its place in the list
+   template <class F>
+   void forKind(size_t index, F f)
+   {
+      size_t i = 0;
+      forEachKind([&](auto & v) { if (i++ == index) f(v); });
+   }
+
+   // the kind at a place in the list
+   template <size_t I>
+   using KindAt = typename std::tuple_element<I, std::tuple<Kinds ...>>::type;
+
+   // the place of a kind in the list
+   template <class T>
+   static constexpr size_t indexOf()
+   {
+      size_t i = 0;
+      size_t found = sizeof...(Kinds);
+      ((std::is_same<T, Kinds>::value ? found = i++ : i++), ...);
+      return found;
+   }
+
+   // remove everything the predicate says to, keeping the rest in order.
+   // The predicate sees each thing exactly once, so it may have side effects.
+   template <class P>
+   void removeIf(P p)
+   {
+      removeIf(p, [](auto &, size_t) {});
+   }
+
+   // the same, telling moved(t, i) whenever a thing that stays
+   // slides down to place i of its vector
+   template <class P, class M>
+   void removeIf(P p, M moved)
+   {
+      std::apply([&](auto & ... v) { (compact(v, p, moved), ...); }, kinds);
+   }
+
+   // how many things are there of all kinds?
+   size_t size() const
+   {
+      return std::apply([](const auto & ... v) { return (v.size() + ... + 0); }, kinds);
+   }
+
+   // get rid of everything
+   void clear()
+   {
+      std::apply([](auto & ... v) { (v.clear(), ...); }, kinds);
+   }
+
+private:
+   template <class V, class F>
+   static void visit(V & v, F & f)
+   {
+      for (auto & t : v)
+         f(t);
+   }
+
+   template <class T, class P, class M>
+   static void compact(std::vector<T> & v, P & p, M & moved)
+   {
+      size_t keep = 0;
+      for (size_t i = 0; i < v.size(); i++)
+         if (!p(v[i]))
+         {
+            if (keep != i)
+            {
+               v[keep] = std::move(v[i]);
+               moved(v[keep], keep);
+            }
+            keep++;
+         }
+      v.erase(v.begin() + keep, v.end());
+   }
+
+   std::tuple<std::vector<Kinds> ...> kinds;
+};
@@ -32,6 +32,7 @@ class Score : public Status
 public:
     Score() { reset(); }
     std::string getText() const;
+    int getPoints() const { return points; }
     void adjust(int value) { points += value; }
     void reset() { points = 0; }
 private:
@@ -47,6 +48,8 @@ class HitRatio : public Status
 public:
     HitRatio()  { reset(); }
     std::string getText() const;
+    int getKilled() const { return numKilled; }
+    int getMissed() const { return numMissed; }
     void adjust(int value);
     void reset() { numKilled = numMissed = 0; }
 private:
@@ -5,31 +5,232 @@
 
 #include <string>
 #include <sstream>
+#include <type_traits>
+#include <algorithm>
 #include "skeet.h"
+#include "dice.h"
 using namespace std;
 
+// how many birds, bullets, or effects one job handles at a time. Moving
+// one is a handful of arithmetic, so a pass is only split once it is
+// bigger than this: the birds and bullets rarely are, the fragments of
+// a few hits at once often are
+const size_t GRAIN = 64;
+
+// every bird is checked against every bullet, so far fewer birds per job
+const size_t HIT_GRAIN = 8;
+
+// rounding room for ruling out a pair before minimumDistance(), in pixels
+const double HIT_SLACK = 1.0e-6;
+
+// the census counts the birds and the bullets in roster order
+static_assert(Census::FLOATER - Census::STANDARD == Skeet::Birds::indexOf<Floater>() &&
+              Census::SINKER  - Census::STANDARD == Skeet::Birds::indexOf<Sinker>()  &&
+              Census::CRAZY   - Census::STANDARD == Skeet::Birds::indexOf<Crazy>(),
+              "the census and the bird roster disagree");
+static_assert(Census::MISSILE  - Census::PELLET == Skeet::Bullets::indexOf<Missile>() &&
+              Census::BOMB     - Census::PELLET == Skeet::Bullets::indexOf<Bomb>()    &&
+              Census::SHRAPNEL - Census::PELLET == Skeet::Bullets::indexOf<Shrapnel>(),
+              "the census and the bullet roster disagree");
+
+// the level table names the birds in roster order
+static_assert(SpawnRule::FLOATER == Skeet::Birds::indexOf<Floater>() &&
+              SpawnRule::SINKER  == Skeet::Birds::indexOf<Sinker>()  &&
+              SpawnRule::CRAZY   == Skeet::Birds::indexOf<Crazy>(),
+              "the level table and the bird roster disagree");
 
-#ifdef __APPLE__
-#define GL_SILENCE_DEPRECATION
-#include <openGL/gl.h>    // Main OpenGL library
-#include <GLUT/glut.h>    // Second OpenGL library
-#define GLUT_TEXT GLUT_BITMAP_HELVETICA_18
-#endif // __APPLE__
-
-#ifdef __linux__
-#include <GL/gl.h>        // Main OpenGL library
-#include <GL/glut.h>      // Second OpenGL library
-#define GLUT_TEXT GLUT_BITMAP_HELVETICA_12
-#endif // __linux__
-
-#ifdef _WIN32
-#include <stdio.h>
-#include <stdlib.h>
-#include <GL/glut.h>         // OpenGL library we copied 
-#define _USE_MATH_DEFINES
-#include <math.h>
-#define GLUT_TEXT GLUT_BITMAP_HELVETICA_12
-#endif // _WIN32
+/************************
+ * SKEET LAUNCH
+ * a new bird or bullet, straight into play
+ ************************/
+template <class T>
+void Skeet::launch(const T & thing, unsigned int last, unsigned int earliest)
+{
+   if constexpr (std::is_base_of<Bird, T>::value)
+   {
+      std::vector<T> & kind = birds.get<T>();
+      kind.push_back(thing);
+      enroll(kind.back(), kind.size() - 1, last, earliest);
+   }
+   else
+   {
+      std::vector<T> & kind = bullets.get<T>();
+      kind.push_back(thing);
+      enroll(kind.back(), kind.size() - 1, last, earliest);
+   }
+}
+
+/************************
+ * SKEET ENROLL
+ * a bird or bullet that was just put at this place in its roster gets
+ * a handle so the wheels can find it again. Bullets that burn out are
+ * put on the wheel for when they do.
+ ************************/
+template <class T>
+void Skeet::enroll(T & thing, size_t place, unsigned int last, unsigned int earliest)
+{
+   if constexpr (std::is_base_of<Bird, T>::value)
+   {
+      thing.setHandle(birdSlots[Birds::indexOf<T>()].insert(place));
+      census.made(Census::STANDARD + Birds::indexOf<T>());
+   }
+   else
+   {
+      thing.setHandle(bulletSlots[Bullets::indexOf<T>()].insert(place));
+      census.made(Census::PELLET + Bullets::indexOf<T>());
+      if (thing.getLifetime())
+         bulletDeaths.schedule(last + thing.getLifetime(), tagOf<Bullets>(thing));
+   }
+   expect(thing, last, earliest);
+}
+
+/************************
+ * SKEET COMMIT
+ * put in play everything that was made while the contacts and the
+ * rosters were being walked: the shrapnel of bombs that went off, the
+ * fragments of birds that were hit, and the point values of whatever
+ * died. Each kind goes in as one block, in the order it was made, and
+ * the staging buffers keep their room for the next frame.
+ ************************/
+void Skeet::commit()
+{
+   bullets.forEachKind([&](auto & kind)
+   {
+      using Kind = typename std::decay_t<decltype(kind)>::value_type;
+      std::vector<Kind> & staged = stagedBullets.get<Kind>();
+      if (staged.empty())
+         return;
+      size_t first = kind.size();
+      kind.insert(kind.end(), staged.begin(), staged.end());
+      staged.clear();
+      for (size_t i = first; i < kind.size(); i++)
+         enroll(kind[i], i, frame, frame + 1);
+   });
+
+   for (auto effect : stagedEffects)
+      addEffect(effect, frame);
+   stagedEffects.clear();
+
+   for (auto & pts : stagedPoints)
+      addPoints(pts);
+   stagedPoints.clear();
+}
+
+/************************
+ * SKEET EXPECT
+ * work out when a bird or bullet will leave the screen and put it on
+ * the wheel for that frame. Any earlier entry is left to go stale.
+ ************************/
+template <class T>
+void Skeet::expect(T & thing, unsigned int last, unsigned int earliest)
+{
+   unsigned int frames = framesToExit(thing.getPosition(), thing.getVelocity(),
+                                      thing.getRadius(), T::flight(*pTuning), dimensions);
+   if (frames == NEVER)
+   {
+      thing.setExitFrame(0);
+      return;
+   }
+
+   unsigned int due = last + frames < earliest ? earliest : last + frames;
+   thing.setExitFrame(due);
+   if constexpr (std::is_base_of<Bird, T>::value)
+      birdExits.schedule(due, tagOf<Birds>(thing));
+   else
+      bulletExits.schedule(due, tagOf<Bullets>(thing));
+}
+
+/************************
+ * SKEET FIND
+ * the bird or bullet with this tag, handed to f, if it is still there
+ ************************/
+template <class R, class F>
+void Skeet::find(R & roster, const Tag & tag, F f)
+{
+   const SlotMap & slots = slotsFor(roster)[tag.kind];
+   if (!slots.isValid(tag.handle))
+      return;
+   roster.forKind(tag.kind, [&](auto & kind)
+   {
+      auto & thing = kind[slots.find(tag.handle)];
+      assert(thing.getHandle() == tag.handle);
+      f(thing);
+   });
+}
+
+/************************
+ * SKEET REMOVE
+ * everything p says is dead, out of the roster. The handle of one that
+ * is gone is no good from then on, and the slot of one that slides
+ * down is told where it went, so the wheels still find it.
+ ************************/
+template <class R, class P>
+void Skeet::remove(R & roster, P p)
+{
+   SlotMap * slots = slotsFor(roster);
+   int first = censusOf(roster);
+   roster.removeIf([&](auto & thing)
+   {
+      if (!p(thing))
+         return false;
+      size_t kind = R::template indexOf<std::decay_t<decltype(thing)>>();
+      slots[kind].erase(thing.getHandle());
+      census.gone(first + (int)kind);
+      return true;
+   },
+   [&](auto & thing, size_t place)
+   {
+      slots[R::template indexOf<std::decay_t<decltype(thing)>>()].move(thing.getHandle(), place);
+   });
+}
+
+/************************
+ * SKEET EXPIRE
+ * everything the wheel says should have left the screen by now. The
+ * prediction is never late but may be early, so check, and if it is
+ * still on the screen, work it out again.
+ ************************/
+template <class R>
+void Skeet::expire(R & roster, TimerWheel<Tag> & wheel)
+{
+   wheel.expire(frame, [&](const Tag & tag)
+   {
+      find(roster, tag, [&](auto & thing)
+      {
+         // its course changed since this was scheduled
+         if (thing.getExitFrame() != frame || thing.isDead())
+            return;
+
+         thing.escape();
+         if (!thing.isDead())
+            expect(thing, frame, frame + 1);
+         else if constexpr (std::is_base_of<Bird, std::decay_t<decltype(thing)>>::value)
+            hitRatio.adjust(-1);
+      });
+   });
+}
+
+/************************
+ * SKEET ADD EFFECT
+ * an effect, on the wheel for the frame it fades out
+ ************************/
+void Skeet::addEffect(Effect * effect, unsigned int last)
+{
+   effects.push_back(effect);
+   census.made(Census::FRAGMENT);
+   effectDeaths.schedule(last + effect->getLifetime(), effect);
+}
+
+/************************
+ * SKEET ADD POINTS
+ * a point value, on the wheel for the frame it fades out
+ ************************/
+void Skeet::addPoints(const Points & pts)
+{
+   points.push_back(pts);
+   census.made(Census::POINTS);
+   pointDeaths.schedule(frame + pts.getLifetime(), pts.getValue());
+}
 
 /************************
  * SKEET ANIMATE
@@ -37,452 +238,611 @@ using namespace std;
  ************************/
 void Skeet::animate()
 {
+   frame++;
    time++;
+   census.startFrame(frame, time.level());
    
    // if status, then do not move the game
    if (time.isStatus())
    {
       // get rid of the bullets and the birds without changing the score
+      birds.forEachKind([&](auto & kind)
+      {
+         using Kind = typename std::decay_t<decltype(kind)>::value_type;
+         census.gone(Census::STANDARD + Birds::indexOf<Kind>(), kind.size());
+      });
+      bullets.forEachKind([&](auto & kind)
+      {
+         using Kind = typename std::decay_t<decltype(kind)>::value_type;
+         census.gone(Census::PELLET + Bullets::indexOf<Kind>(), kind.size());
+      });
       birds.clear();
       bullets.clear();
+      for (auto & slots : birdSlots)
+         slots.clear();
+      for (auto & slots : bulletSlots)
+         slots.clear();
+      birdExits.clear();
+      bulletExits.clear();
+      bulletDeaths.clear();
+      effectDeaths.clear();
+      pointDeaths.clear();
+      for (auto & chance : spawns)
+         chance.reset();
+
+      // everything the last level made goes at once
+      census.gone(Census::FRAGMENT, effects.size());
+      census.gone(Census::SMOKE, smoke.size());
+      census.gone(Census::POINTS, points.size());
       effects.clear();
+      smoke.clear();
       points.clear();
+      arena.reset();
+      takeCensus();
       return;
    }
    
    // spawn
    spawn();
    
-   // move the birds and the bullets
-   for (auto element : birds)
+   // move the birds. Crazy birds draw random numbers as they fly, so
+   // they go one at a time to keep the sequence the same as a replay's.
+   // A turn changes when they will leave the screen.
+   const Tuning & tuning = *pTuning;
+   birds.forEachKind([&](auto & kind)
    {
-      element->advance();
-      hitRatio.adjust(element->isDead() ? -1 : 0);
-   }
-   for (auto bullet : bullets)
-      bullet->move(effects);
-   for (auto effect : effects)
-      effect->fly();
+      using Kind = typename std::decay_t<decltype(kind)>::value_type;
+      if (std::is_same<Kind, Crazy>::value)
+         for (auto & element : kind)
+         {
+            Velocity v = element.getVelocity();
+            element.fly(tuning);
+            if (v.getDx() != element.getVelocity().getDx() ||
+                v.getDy() != element.getVelocity().getDy())
+               expect(element, frame, frame);
+         }
+      else
+         jobs.parallelFor(kind.size(), GRAIN, [&](size_t begin, size_t end)
+         {
+            for (size_t i = begin; i < end; i++)
+               kind[i].fly(tuning);
+         });
+   });
+
+   // move the bullets. Each keeps its own trail, so none touch another
+   bullets.forEachKind([&](auto & kind)
+   {
+      jobs.parallelFor(kind.size(), GRAIN, [&](size_t begin, size_t end)
+      {
+         for (size_t i = begin; i < end; i++)
+            kind[i].fly();
+      });
+   });
+
+   // bombs and shrapnel whose time is up
+   bulletDeaths.expire(frame, [&](const Tag & tag)
+   {
+      find(bullets, tag, [](auto & bullet) { bullet.kill(); });
+   });
+
+   // only what was due to leave the screen is checked
+   expire(birds, birdExits);
+   expire(bullets, bulletExits);
+
+   // move the effects. Only the points wander at random
+   jobs.parallelFor(effects.size(), GRAIN, [&](size_t begin, size_t end)
+   {
+      for (size_t i = begin; i < end; i++)
+         effects[i]->fly();
+   });
+   smoke.forEach([](auto & trail) { trail.fly(); });
    for (auto & pts : points)
       pts.update();
       
    // hit detection
-   for (auto element : birds)
-      for (auto bullet : bullets)
-         if (!element->isDead() && !bullet->isDead() &&
-             element->getRadius() + bullet->getRadius() >
-             minimumDistance(element->getPosition(), element->getVelocity(),
-                             bullet->getPosition(),  bullet->getVelocity()))
-         {
-            for (int i = 0; i < 25; i++)
-               effects.push_back(new Fragment(bullet->getPosition(), bullet->getVelocity()));
-            element->kill();
-            bullet->kill();
-            hitRatio.adjust(1);
-            bullet->setValue(-(element->getPoints()));
-            element->setPoints(0);
-         }
+   detectHits();
    
    // remove the zombie birds
-   for (auto it = birds.begin(); it != birds.end();)
-      if ((*it)->isDead())
-      {
-         if ((*it)->getPoints())
-            points.push_back(Points((*it)->getPosition(), (*it)->getPoints()));
-         score.adjust((*it)->getPoints());
-         it = birds.erase(it);
-      }
-      else
-         ++it;
+   remove(birds, [&](auto & element)
+   {
+      if (!element.isDead())
+         return false;
+      if (element.getPoints())
+         stagedPoints.push_back(Points(element.getPosition(), element.getPoints()));
+      score.adjust(element.getPoints());
+      return true;
+   });
        
-   // remove zombie bullets
-   for (auto it = bullets.begin(); it != bullets.end(); )
-      if ((*it)->isDead())
-      {
-         (*it)->death(bullets);
-         int value = -(*it)->getValue();
-         points.push_back(Points((*it)->getPosition(), value));
-         score.adjust(value);
-         it = bullets.erase(it);
-      }
-      else
-         ++it;
+   // remove zombie bullets. Bombs leave shrapnel behind, and trails smoke
+   std::vector<Shrapnel> & shrapnel = stagedBullets.get<Shrapnel>();
+   size_t numSmoke = smoke.size();
+   remove(bullets, [&](auto & bullet)
+   {
+      if (!bullet.isDead())
+         return false;
+      bullet.burst(shrapnel, *pTuning);
+      bullet.leaveSmoke(smoke);
+      int value = -bullet.getValue();
+      stagedPoints.push_back(Points(bullet.getPosition(), value));
+      score.adjust(value);
+      return true;
+   });
+   census.made(Census::SMOKE, smoke.size() - numSmoke);
+
+   // nothing is being walked now, so what was made can go in
+   commit();
    
-   // remove zombie fragments
-   for (auto it = effects.begin(); it != effects.end();)
-      if ((*it)->isDead())
-         it = effects.erase(it);
-      else
-         ++it;
+   // remove zombie fragments. The wheel says how many faded out this
+   // frame; once they are all found, the rest slide down in one move.
+   // Their memory stays in the arena until the level is over.
+   size_t dying = 0;
+   effectDeaths.expire(frame, [&](Effect * effect)
+   {
+      assert(effect->isDead());
+      dying++;
+   });
+   if (dying)
+   {
+      size_t keep = 0;
+      size_t i = 0;
+      for (; dying; i++)
+         if (effects[i]->isDead())
+            dying--;
+         else
+            effects[keep++] = effects[i];
+      keep = std::move(effects.begin() + i, effects.end(), effects.begin() + keep) - effects.begin();
+      census.gone(Census::FRAGMENT, effects.size() - keep);
+      effects.resize(keep);
+   }
 
-   // remove expired points
-   for (auto it = points.begin(); it != points.end();)
-      if ((*it).isDead())
-         it = points.erase(it);
-      else
-         ++it;
+   // remove the smoke that faded out. All the smoke of a kind lasts
+   // as long, so the oldest is always at the front
+   smoke.forEachKind([&](auto & kind)
+   {
+      auto firstLive = std::find_if(kind.begin(), kind.end(),
+                                    [](const auto & trail) { return !trail.isDead(); });
+      census.gone(Census::SMOKE, firstLive - kind.begin());
+      kind.erase(kind.begin(), firstLive);
+   });
+
+   // remove expired points. The wheel says how many faded out this
+   // frame, and since every point value lasts as long, they are the
+   // oldest ones, at the front
+   size_t fading = 0;
+   pointDeaths.expire(frame, [&](int) { fading++; });
+   if (fading)
+   {
+      assert(fading <= points.size() && points[fading - 1].isDead());
+      points.erase(points.begin(), points.begin() + fading);
+      census.gone(Census::POINTS, fading);
+   }
+
+   // the arenas only grow during a level, so this ends up its peak
+   size_t used = arena.getUsed();
+   if (arenaPeaks.size() <= (size_t)time.level())
+      arenaPeaks.resize(time.level() + 1);
+   arenaPeaks[time.level()] = used;
+
+   takeCensus();
 }
 
-/************************************************************************
- * DRAW Background
- * Fill in the background
- *  INPUT color   Background color
- *************************************************************************/
-void Skeet::drawBackground(double redBack, double greenBack, double blueBack) const
+/************************
+ * SKEET TAKE CENSUS
+ * how many of each kind there are and the bytes they hold. A bird or
+ * bullet holds its room in the roster, and shrapnel its room in the
+ * staging buffer too, whether or not the room is in use, and so does a
+ * point value. A fragment holds its room in the arena until the level
+ * is over, even after it fades, so it is every one made this level.
+ ************************/
+void Skeet::takeCensus()
 {
-   glBegin(GL_TRIANGLE_FAN);
+   birds.forEachKind([&](auto & kind)
+   {
+      using Kind = typename std::decay_t<decltype(kind)>::value_type;
+      census.tally(Census::STANDARD + Birds::indexOf<Kind>(), kind.size(),
+                   kind.capacity() * sizeof(Kind));
+   });
+   bullets.forEachKind([&](auto & kind)
+   {
+      using Kind = typename std::decay_t<decltype(kind)>::value_type;
+      census.tally(Census::PELLET + Bullets::indexOf<Kind>(), kind.size(),
+                   (kind.capacity() + stagedBullets.get<Kind>().capacity()) * sizeof(Kind));
+   });
+   census.tally(Census::FRAGMENT, effects.size(),
+                census.getLevel(Census::FRAGMENT).allocs * Arena::footprint(sizeof(Fragment)) +
+                (effects.capacity() + stagedEffects.capacity()) * sizeof(Effect *));
+   size_t smokeBytes = 0;
+   smoke.forEachKind([&](auto & kind)
+   {
+      using Kind = typename std::decay_t<decltype(kind)>::value_type;
+      smokeBytes += kind.capacity() * sizeof(Kind);
+   });
+   census.tally(Census::SMOKE, smoke.size(), smokeBytes);
+   census.tally(Census::POINTS, points.size(),
+                (points.capacity() + stagedPoints.capacity()) * sizeof(Points));
+}
 
-   // two rectangles is the fastest way to fill the screen.
-   glColor3f((GLfloat)redBack /* red % */, (GLfloat)greenBack /* green % */, (GLfloat)blueBack /* blue % */);
-   glVertex2f((GLfloat)0.0, (GLfloat)0.0);
-   glVertex2f((GLfloat)dimensions.getX(), (GLfloat)0.0);
-   glVertex2f((GLfloat)dimensions.getX(), (GLfloat)dimensions.getY());
-   glVertex2f((GLfloat)0.0, (GLfloat)dimensions.getY());
+/************************
+ * SKEET DETECT HITS
+ * Every bird against every bullet. Each chunk of birds writes the
+ * pairs that touch into its own list without changing anything. The
+ * lists are then read in order of bird and, within a bird, in order
+ * of bullet, and a pair only counts if neither one was already hit
+ * by an earlier pair. That is exactly what a single thread would have
+ * done, whatever the number of threads.
+ *
+ * The live bullets are copied into flat arrays first, so the inner loop
+ * streams through plain Vec2s instead of chasing a pointer per bullet.
+ * Two things a frame apart can come no closer than the gap between
+ * them less how fast that gap closes, so most pairs are ruled out by
+ * two lengths before the exact, slice-by-slice minimumDistance().
+ ************************/
+void Skeet::detectHits()
+{
+   // line everyone up in the order they are stored
+   targets.clear();
+   birds.forEach([&](auto & element) { targets.push_back(&element); });
+   shots.clear();
+   shotAt.clear();
+   shotMove.clear();
+   shotRadius.clear();
+   bullets.forEach([&](auto & bullet)
+   {
+      if (bullet.isDead())
+         return;
+      shots.push_back(&bullet);
+      shotAt.push_back(widen(bullet.getPosition().getVec2()));
+      shotMove.push_back(widen(bullet.getVelocity().getVec2()));
+      shotRadius.push_back(bullet.getRadius());
+   });
+
+   // who touched whom?
+   size_t numChunks = JobSystem::numChunks(targets.size(), HIT_GRAIN);
+   if (contacts.size() < numChunks)
+      contacts.resize(numChunks);
+   jobs.parallelFor(targets.size(), HIT_GRAIN, [&](size_t begin, size_t end)
+   {
+      std::vector<Contact> & found = contacts[begin / HIT_GRAIN];
+      for (size_t iBird = begin; iBird < end; iBird++)
+      {
+         const Bird & element = *targets[iBird];
+         if (element.isDead())
+            continue;
+         Position pt = element.getPosition();
+         Velocity v = element.getVelocity();
+         Vec2d at = widen(pt.getVec2());
+         Vec2d move = widen(v.getVec2());
+         double radius = element.getRadius();
+         for (size_t iBullet = 0; iBullet < shots.size(); iBullet++)
+         {
+            double reach = radius + shotRadius[iBullet];
+            if (length(at - shotAt[iBullet]) -
+                length(move - shotMove[iBullet]) > reach + HIT_SLACK)
+               continue;
+            if (reach > minimumDistance(pt, v, shots[iBullet]->getPosition(),
+                                               shots[iBullet]->getVelocity()))
+               found.push_back({ (unsigned int)iBird, (unsigned int)iBullet });
+         }
+      }
+   });
 
-   glEnd();
+   // first come, first served
+   for (size_t chunk = 0; chunk < numChunks; chunk++)
+   {
+      for (auto & contact : contacts[chunk])
+      {
+         Bird & element = *targets[contact.bird];
+         Bullet & bullet = *shots[contact.bullet];
+         if (element.isDead() || bullet.isDead())
+            continue;
+
+         for (int i = 0; i < pTuning->fragmentsPerHit; i++)
+            stagedEffects.push_back(arena.make<Fragment>(bullet.getPosition(), bullet.getVelocity()));
+         element.kill();
+         bullet.kill();
+         hitRatio.adjust(1);
+         bullet.setValue(-(element.getPoints()));
+         element.setPoints(0);
+      }
+      contacts[chunk].clear();
+   }
 }
 
-/************************************************************************
- * DRAW Timer
- * Draw a large timer on the screen
- *  INPUT percent     Amount of time left
- *        Foreground  Foreground color
- *        Background  Background color
- *************************************************************************/
-void Skeet::drawTimer(double percent,
-                     double redFore, double greenFore, double blueFore,
-                     double redBack, double greenBack, double blueBack) const
+/************************
+ * SKEET PUBLISH
+ * copy everything that is drawn into a snapshot, so it can be drawn
+ * on another thread while we go on to the next frame
+ ************************/
+void Skeet::publish(Snapshot & snapshot) const
 {
-   double radians;
-
-   GLfloat length = (GLfloat)dimensions.getX();
-   GLfloat half = length / (GLfloat)2.0;
-
-   // do the background stuff
-   drawBackground(redBack, greenBack, blueBack);
-
-   // foreground stuff
-   radians = percent * M_PI * 2.0;
-   GLfloat x_extent = half + length * (GLfloat)sin(radians);
-   GLfloat y_extent = half + length * (GLfloat)cos(radians);
-
-   // get read to draw the triangles
-   glBegin(GL_TRIANGLE_FAN);
-   glColor3f((GLfloat)redFore /* red % */, (GLfloat)greenFore /* green % */, (GLfloat)blueFore /* blue % */);
-   glVertex2f(half, half);
-
-   // fill in the triangles, one eight at a time
-   switch ((int)(percent * 8.0))
-   {
-   case 7: // 315 - 360
-      glVertex2f(half, length);
-      glVertex2f(length, length);
-      glVertex2f(length, 0.0);
-      glVertex2f(0.0, 0.0);
-      glVertex2f(0.0, length);
-      break;
-   case 6: // 270 - 315
-      glVertex2f(half, length);
-      glVertex2f(length, length);
-      glVertex2f(length, 0.0);
-      glVertex2f(0.0, 0.0);
-      glVertex2f(0.0, half);
-      break;
-   case 5: // 225 - 270
-      glVertex2f(half, length);
-      glVertex2f(length, length);
-      glVertex2f(length, 0.0);
-      glVertex2f(0.0, 0.0);
-      break;
-   case 4: // 180 - 225
-      glVertex2f(half, length);
-      glVertex2f(length, length);
-      glVertex2f(length, 0.0);
-      glVertex2f(half, 0.0);
-      break;
-   case 3: // 135 - 180
-      glVertex2f(half, length);
-      glVertex2f(length, length);
-      glVertex2f(length, half);
-      glVertex2f(length, 0.0);
-      break;
-   case 2: // 90 - 135 degrees
-      glVertex2f(half, length);
-      glVertex2f(length, length);
-      glVertex2f(length, half);
-      break;
-   case 1: // 45 - 90 degrees
-      glVertex2f(half, length);
-      glVertex2f(length, length);
-      break;
-   case 0: // 0 - 45 degrees
-      glVertex2f(half, length);
-      break;
-   }
-   glVertex2f(x_extent, y_extent);
-
-   // complete drawing
-   glEnd();
-
-   // draw the red line now
-   glBegin(GL_LINES);
-   glColor3f((GLfloat)0.6, (GLfloat)0.0, (GLfloat)0.0);
-   glVertex2f(half, half);
-   glVertex2f(x_extent, y_extent);
-   glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)1.0 /* blue % */);
-   glEnd();
+   snapshot.dimensions = dimensions;
+   snapshot.gun        = gun;
+   snapshot.bullseye   = bullseye;
+   snapshot.time       = time;
+   snapshot.score      = score;
+   snapshot.hitRatio   = hitRatio;
+   snapshot.birds      = birds;
+   snapshot.bullets    = bullets;
+   snapshot.effects.clear();
+   for (auto effect : effects)
+      effect->copyInto(snapshot.effects);
+   smoke.forEach([&](const auto & trail) { trail.copyInto(snapshot.effects); });
+   snapshot.points.assign(points.begin(), points.end());
+   snapshot.frame      = frame;
 }
 
-/*************************************************************************
- * DRAW TEXT
- * Draw text using a simple bitmap font
- *   INPUT  topLeft   The top left corner of the text
- *          text      The text to be displayed
- ************************************************************************/
-void drawText(const Position& topLeft, const char* text) 
+/************************
+ * SKEET EXECUTE
+ * carry out one frame worth of commands
+ ************************/
+void Skeet::execute(const vector<Command> & commands)
 {
-   void* pFont = GLUT_TEXT;
-   glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)1.0 /* blue % */);
+   int clockwise = 0;
+   int counterclockwise = 0;
+   bool isUp = false;
+   bool isDown = false;
+   bool isPellet = false;
+   bool isMissile = false;
+   bool isBomb = false;
+   bool isBullseye = false;
+
+   // gather what was asked of us this frame
+   for (auto & command : commands)
+      switch (command.type)
+      {
+         case ROTATE_GUN:
+            clockwise = command.a;
+            counterclockwise = command.b;
+            break;
+         case STEER_MISSILE:
+            isUp = command.a != 0;
+            isDown = command.b != 0;
+            break;
+         case FIRE_PELLET:
+            isPellet = true;
+            break;
+         case FIRE_MISSILE:
+            isMissile = true;
+            break;
+         case FIRE_BOMB:
+            isBomb = true;
+            break;
+         case BULLSEYE:
+            isBullseye = true;
+            break;
+         default:
+            break;
+      }
 
-   // prepare to output the text from the top-left corner
-   glRasterPos2f((GLfloat)topLeft.getX(), (GLfloat)topLeft.getY());
+   // reset the game
+   if (time.isGameOver() && isPellet)
+   { 
+      time.reset();
+      score.reset();
+      hitRatio.reset();
+      return;
+   }
 
-   // loop through the text
-   for (const char* p = text; *p; p++)
-      glutBitmapCharacter(pFont, *p);
-}
-void drawText(const Position & topLeft, const string & text)
-{
-   drawText(topLeft, text.c_str());
+   // move the gun
+   gun.interact(clockwise, counterclockwise);
+
+   // a pellet can be shot at any time
+   if (isPellet)
+      launch(Pellet(gun.getAngle(), pTuning->pelletSpeed), frame, frame + 1);
+   // missiles can be shot at level 2 and higher
+   else if (isMissile && time.level() > 1)
+      launch(Missile(gun.getAngle(), pTuning->missileSpeed), frame, frame + 1);
+   // bombs can be shot at level 3 and higher
+   else if (isBomb && time.level() > 2)
+      launch(Bomb(gun.getAngle(), pTuning->bombSpeed), frame, frame + 1);
+   
+   bullseye = isBullseye;
+
+   // send movement information to the missiles, the only ones who care.
+   // Steering changes when they will leave the screen.
+   for (auto & missile : bullets.get<Missile>())
+   {
+      missile.steer(isUp, isDown);
+      if (isUp || isDown)
+         expect(missile, frame, frame + 1);
+   }
 }
 
 /************************
- * DRAW BULLSEYE
- * Put a bullseye on the screen
+ * SKEET CHECKSUM
+ * Fold the entire game state into 64 bits (FNV-1a) so a replay
+ * can prove it arrived at exactly the same place as the recording
  ************************/
-void Skeet::drawBullseye(double angle) const
+static void fold(unsigned long long & h, const void * p, size_t size)
 {
-   // find where we are pointing
-   double distance = dimensions.getX();
-   GLfloat x = dimensions.getX() - distance * cos(angle);
-   GLfloat y = distance * sin(angle);
-
-   // draw the crosshairs
-   glBegin(GL_LINES);
-   glColor3f((GLfloat)0.6, (GLfloat)0.6, (GLfloat)0.6);
+   const unsigned char * bytes = (const unsigned char *)p;
+   for (size_t i = 0; i < size; i++)
+   {
+      h ^= bytes[i];
+      h *= 0x100000001b3ULL;
+   }
+}
+static void fold(unsigned long long & h, double value)
+{
+   fold(h, &value, sizeof(value));
+}
+static void fold(unsigned long long & h, const Position & pt)
+{
+   fold(h, pt.getX());
+   fold(h, pt.getY());
+}
+static void fold(unsigned long long & h, const Velocity & v)
+{
+   fold(h, v.getDx());
+   fold(h, v.getDy());
+}
+static void fold(unsigned long long & h, const string & text)
+{
+   fold(h, text.data(), text.size());
+}
 
-   // Draw the actual lines
-   glVertex2f(x - 10.0, y);
-   glVertex2f(x + 10.0, y);
+unsigned long long Skeet::checksum() const
+{
+   unsigned long long h = 0xcbf29ce484222325ULL;
 
-   glVertex2f(x, y - 10.0);
-   glVertex2f(x, y + 10.0);
+   fold(h, (double)frame);
+   fold(h, gun.getAngle());
+   fold(h, time.getText());
+   fold(h, (double)time.level());
+   fold(h, score.getText());
+   fold(h, hitRatio.getText());
 
-   glColor3f((GLfloat)0.2, (GLfloat)0.2, (GLfloat)0.2);
-   glVertex2f(dimensions.getX(), 0.0);
-   glVertex2f(x, y);
+   birds.forEach([&h](const auto & element)
+   {
+      fold(h, element.getPosition());
+      fold(h, element.getVelocity());
+      fold(h, element.getRadius());
+      fold(h, (double)element.getPoints());
+   });
+   bullets.forEach([&h](const auto & bullet)
+   {
+      fold(h, bullet.getPosition());
+      fold(h, bullet.getVelocity());
+      fold(h, (double)bullet.getValue());
+   });
+   for (auto effect : effects)
+   {
+      fold(h, effect->getPosition());
+      fold(h, effect->getAge());
+   }
+   // the smoke is only drawn, like the trails it was, so it is left out
+   for (auto & pts : points)
+   {
+      fold(h, pts.getPosition());
+      fold(h, (double)pts.getValue());
+   }
 
-   // Complete drawing
-   glEnd();
+   return h;
 }
 
 /************************
- * SKEET DRAW LEVEL
- * output everything that will be on the screen
+ * SKEET SET LEVELS
+ * play these levels instead of the ones built in, from the start
  ************************/
-void Skeet::drawLevel() const
+void Skeet::setLevels(const LevelTable & levels)
 {
-   // output the background
-   drawBackground(time.level() * .1, 0.0, 0.0);
-   
-   // draw the bullseye
-   if (bullseye)
-      drawBullseye(gun.getAngle());
-
-   // output the gun
-   gun.display();
-         
-   // output the birds, bullets, and fragments
-   for (auto& pts : points)
-      pts.show();
-   for (auto effect : effects)
-      effect->render();
-   for (auto bullet : bullets)
-      bullet->output();
-   for (auto element : birds)
-      element->draw();
-   
-   // status
-   drawText(Position(10,                         dimensions.getY() - 30), score.getText()  );
-   drawText(Position(dimensions.getX() / 2 - 30, dimensions.getY() - 30), time.getText()   );
-   drawText(Position(dimensions.getX() - 110,    dimensions.getY() - 30), hitRatio.getText());
+   pLevels = std::make_shared<LevelTable>(levels);
+   setTuning(pTuning);
+   time.reset();
+   for (auto & chance : spawns)
+      chance.reset();
 }
 
 /************************
- * SKEET DRAW STATUS
- * place the status message on the center of the screen
+ * SAME ODDS
+ * does a level send up its birds as often under both rules?
  ************************/
-void Skeet::drawStatus() const
+static bool isSameOdds(const LevelRule & lhs, const LevelRule & rhs)
 {
-   // output the text information
-   ostringstream sout;
-   if (time.isGameOver())
-   {
-      // draw the end of game message
-      drawText(Position(dimensions.getX() / 2 - 30, dimensions.getY() / 2 + 10),
-               "Game Over");
+   if (lhs.numSpawns != rhs.numSpawns)
+      return false;
+   for (int i = 0; i < lhs.numSpawns; i++)
+      if (lhs.spawns[i].oneIn != rhs.spawns[i].oneIn)
+         return false;
+   return true;
+}
 
-      // draw end of game status
-      drawText(Position(dimensions.getX() / 2 - 30, dimensions.getY() / 2 - 10),
-               score.getText());
-   }
-   else
+/************************
+ * SKEET SET TUNING
+ * play on with these numbers. The level keeps the time it has had,
+ * and where each bird and bullet will leave the screen is worked out
+ * again, since drag, gravity, and buoyancy may all be different.
+ * Levels from setLevels() stay. If this level's odds change, the
+ * waits already rolled under the old ones are forgotten
+ ************************/
+void Skeet::setTuning(std::shared_ptr<const Tuning> pTuning)
+{
+   if (pLevels)
    {
-      // output the status timer
-      drawTimer(1.0 - time.percentLeft(),
-                     (time.level() - 0.0) * .1, 0.0, 0.0,
-                     (time.level() - 1.0) * .1, 0.0, 0.0);
-
-      // draw the message giving a countdown
-      sout << "Level " << time.level()
-           << " begins in " << time.secondsLeft() << " seconds";
-      drawText(Position(dimensions.getX() / 2 - 110, dimensions.getY() / 2 - 10),
-         sout.str());
+      std::shared_ptr<Tuning> pOver = std::make_shared<Tuning>(*pTuning);
+      pOver->levels = *pLevels;
+      pTuning = pOver;
    }
+   if (!isSameOdds(this->pTuning->levels[time.level()], pTuning->levels[time.level()]))
+      for (auto & chance : spawns)
+         chance.reset();
+
+   this->pTuning = std::move(pTuning);
+   time.setLengths(this->pTuning->levels);
+   birds.forEach([&](auto & element) { expect(element, frame, frame + 1); });
+   bullets.forEach([&](auto & bullet) { expect(bullet, frame, frame + 1); });
 }
 
 /************************
- * SKEET INTERACT
- * handle all user input
+ * SKEET SPAWN
+ * lanuch new birds. The built-in numbers have a routine for each level;
+ * any others are walked rule by rule. SKEET_RUNTIME_LEVELS walks the
+ * built-in table too, as if it had come from a file, so the two ways
+ * can be timed
  ************************/
-void Skeet::interact(const UserInput & ui)
+void Skeet::spawn()
 {
-   // reset the game
-   if (time.isGameOver() && ui.isSpace())
-   { 
-      time.reset();
-      score.reset();
-      hitRatio.reset();
+#ifndef SKEET_RUNTIME_LEVELS
+   if (pTuning.get() == &TUNING)
+   {
+      (this->*spawners[time.level()])();
       return;
    }
+#endif // !SKEET_RUNTIME_LEVELS
+   spawn(pTuning->levels[time.level()]);
+}
 
-   // gather input from the interface
-   gun.interact(ui.isUp() + ui.isRight(), ui.isDown() + ui.isLeft());
-   Bullet *p = nullptr;
+// the spawn routine of each built-in level, game over included
+const std::array<Skeet::Spawner, NUM_LEVELS + 1> Skeet::spawners =
+   Skeet::spawnersFor(std::make_index_sequence<NUM_LEVELS + 1>());
 
-   // a pellet can be shot at any time
-   if (ui.isSpace())
-      p = new Pellet(gun.getAngle());
-   // missiles can be shot at level 2 and higher
-   else if (ui.isM() && time.level() > 1)
-      p = new Missile(gun.getAngle());
-   // bombs can be shot at level 3 and higher
-   else if (ui.isB() && time.level() > 2)
-      p = new Bomb(gun.getAngle());
-   
-   bullseye = ui.isShift();
-
-   // add something if something has been added
-   if (nullptr != p)
-      bullets.push_back(p);
-   
-   // send movement information to all the bullets. Only the missile cares.
-   for (auto bullet : bullets)
-      bullet->input(ui.isUp() + ui.isRight(), ui.isDown() + ui.isLeft(), ui.isB()); 
+/************************
+ * SKEET SPAWN LEVEL
+ * every rule of built-in level L, one after the other
+ ************************/
+template <int L>
+void Skeet::spawnLevel()
+{
+   spawnRules<L>(std::make_index_sequence<LEVELS[L].numSpawns>());
 }
-
-/******************************************************************
- * RANDOM
- * This function generates a random number.
- *
- *    INPUT:   min, max : The number of values (min <= num <= max)
- *    OUTPUT   <return> : Return the integer
- ****************************************************************/
-int random(int min, int max)
+template <int L, size_t ... I>
+void Skeet::spawnRules(std::index_sequence<I ...>)
 {
-   assert(min < max);
-   int num = (rand() % (max - min)) + min;
-   assert(min <= num && num <= max);
+   (spawnRule<L, I>(), ...);
+}
 
-   return num;
+/************************
+ * SKEET SPAWN RULE
+ * rule I of built-in level L. The kind, the numbers, and whether the
+ * screen has to be empty are all known when the game is built
+ ************************/
+template <int L, size_t I>
+void Skeet::spawnRule()
+{
+   constexpr SpawnRule rule = LEVELS[L].spawns[I];
+   if constexpr (rule.isWhenEmpty)
+      if (birds.size() != 0)
+         return;
+   if (spawns[I].happens(rule.oneIn))
+      launch(Birds::KindAt<rule.kind>(rule.radius, rule.speed, rule.points), frame - 1, frame);
 }
 
 /************************
- * SKEET SPAWN
- * lanuch new birds
+ * SKEET SPAWN : LEVEL RULE
+ * every rule of a level that was read in, looked up as it goes
  ************************/
-void Skeet::spawn()
+void Skeet::spawn(const LevelRule & level)
 {
-   double size;
-   switch (time.level())
-   {
-      // in level 1 spawn big birds occasionally
-      case 1:
-         size = 30.0;
-         // spawns when there is nothing on the screen
-         if (birds.size() == 0 && random(0, 15) == 1)
-            birds.push_back(new Standard(size, 7.0));
-         
-         // spawn every 4 seconds
-         if (random(0, 4 * 30) == 1)
-            birds.push_back(new Standard(size, 7.0));
-         break;
-         
-      // two kinds of birds in level 2
-      case 2:
-         size = 25.0;
-         // spawns when there is nothing on the screen
-         if (birds.size() == 0 && random(0, 15) == 1)
-            birds.push_back(new Standard(size, 7.0, 12));
-
-         // spawn every 4 seconds
-         if (random(0, 4 * 30) == 1)
-            birds.push_back(new Standard(size, 5.0, 12));
-         // spawn every 3 seconds
-         if (random(0, 3 * 30) == 1)
-            birds.push_back(new Sinker(size));
-         break;
-      
-      // three kinds of birds in level 3
-      case 3:
-         size = 20.0;
-         // spawns when there is nothing on the screen
-         if (birds.size() == 0 && random(0, 15) == 1)
-            birds.push_back(new Standard(size, 5.0, 15));
-
-         // spawn every 4 seconds
-         if (random(0, 4 * 30) == 1)
-            birds.push_back(new Standard(size, 5.0, 15));
-         // spawn every 4 seconds
-         if (random(0, 4 * 30) == 1)
-            birds.push_back(new Sinker(size, 4.0, 22));
-         // spawn every 4 seconds
-         if (random(0, 4 * 30) == 1)
-            birds.push_back(new Floater(size));
-         break;
-         
-      // three kinds of birds in level 4
-      case 4:
-         size = 15.0;
-         // spawns when there is nothing on the screen
-         if (birds.size() == 0 && random(0, 15) == 1)
-            birds.push_back(new Standard(size, 4.0, 18));
-
-         // spawn every 4 seconds
-         if (random(0, 4 * 30) == 1)
-            birds.push_back(new Standard(size, 4.0, 18));
-         // spawn every 4 seconds
-         if (random(0, 4 * 30) == 1)
-            birds.push_back(new Sinker(size, 3.5, 25));
-         // spawn every 4 seconds
-         if (random(0, 4 * 30) == 1)
-            birds.push_back(new Floater(size, 4.0, 25));
-         // spawn every 4 seconds
-         if (random(0, 4 * 30) == 1)
-            birds.push_back(new Crazy(size));
-         break;
-         
-      default:
-         break;
+   for (int i = 0; i < level.numSpawns; i++)
+   {
+      const SpawnRule & rule = level.spawns[i];
+      if (rule.isWhenEmpty && birds.size() != 0)
+         continue;
+      if (spawns[i].happens(rule.oneIn))
+         birds.forKind(rule.kind, [&](auto & kind)
+         {
+            using Kind = typename std::decay_t<decltype(kind)>::value_type;
+            launch(Kind(rule.radius, rule.speed, rule.points), frame - 1, frame);
+         });
    }
 }
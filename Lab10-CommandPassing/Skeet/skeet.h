@@ -18,8 +18,21 @@
 #include "time.h"
 #include "score.h"
 #include "points.h"
+#include "command.h"
+#include "roster.h"
+#include "jobSystem.h"
+#include "snapshot.h"
+#include "timerWheel.h"
+#include "arena.h"
+#include "handle.h"
+#include "census.h"
+#include "levels.h"
+#include "tuning.h"
 
-#include <list>
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
 
 /*************************************************************************
  * Skeet
@@ -28,38 +41,158 @@
 class Skeet
 {
 public:
-    Skeet(Position & dimensions) : dimensions(dimensions),
-        gun(Position(800.0, 0.0)), time(), score(), hitRatio(), bullseye(false) {}
+    typedef Roster<Standard, Floater, Sinker, Crazy> Birds;
+    typedef Roster<Pellet, Missile, Bomb, Shrapnel>  Bullets;
+
+    Skeet(Position & dimensions, JobSystem & jobs = JobSystem::shared()) :
+        dimensions(dimensions),
+        gun(Position(800.0, 0.0)),
+        pTuning(builtInTuning()),
+        time(), score(), hitRatio(), bullseye(false),
+        frame(0), jobs(jobs) {}
+    Skeet(const Skeet &) = delete;
+
+    // play these levels instead of the ones built in, from the start,
+    // whatever levels a tuning set later brings
+    void setLevels(const LevelTable & levels);
+
+    // between frames: play on with these numbers. The birds and bullets
+    // already out fly by them from the next frame on
+    void setTuning(std::shared_ptr<const Tuning> pTuning);
+    const Tuning & getTuning() const { return *pTuning; }
 
     // handle all user input
-    void interact(const UserInput& ui);
+    void interact(const UserInput& ui) { execute(translate(ui, frame)); }
+
+    // carry out one frame worth of commands
+    void execute(const std::vector<Command> & commands);
 
     // move the gameplay by one unit of time
     void animate();
 
-    // output everything on the screen
-    void drawLevel()  const;    // output the game
-    void drawStatus() const;    // output the status information
+    // copy everything that is drawn, to be drawn later or elsewhere
+    void publish(Snapshot & snapshot) const;
 
     // is the game currently playing right now?
     bool isPlaying() const { return time.isPlaying();  }
+
+    // how many times has animate() been called?
+    unsigned int getFrame() const { return frame; }
+
+    // what a player (or a bot) can see
+    const Birds & getBirds() const { return birds; }
+    double getGunAngle() const { return gun.getAngle();         }
+    int    getScore()    const { return score.getPoints();      }
+    int    getKilled()   const { return hitRatio.getKilled();   }
+    int    getMissed()   const { return hitRatio.getMissed();   }
+    int    getLevel()    const { return time.level();           }
+    bool   isGameOver()  const { return time.isGameOver();      }
+
+    // a fingerprint of the entire game state, used to verify replays
+    unsigned long long checksum() const;
+
+    // the most arena memory the effects of a level took, in
+    // bytes, for each level played so far
+    size_t getArenaPeak(int level) const
+    {
+       return level >= 0 && level < (int)arenaPeaks.size() ? arenaPeaks[level] : 0;
+    }
+    int getArenaLevels() const { return (int)arenaPeaks.size(); }
+
+    // how many of each kind of thing there are and what they hold
+    const Census & getCensus() const { return census; }
 private:
-    // generate new birds
-    void spawn();                  
-    void drawBackground(double redBack, double greenBack, double blueBack) const;
-    void drawTimer(double percent,
-                   double redFore, double greenFore, double blueFore,
-                   double redBack, double greenBack, double blueBack) const;
-    void drawBullseye(double angle) const;
+    // generate new birds. Each built-in level has its own routine, made
+    // from LEVELS when the game is built; a level from a file is walked
+    // rule by rule
+    void spawn();
+    void spawn(const LevelRule & level);
+    template <int L> void spawnLevel();
+    template <int L, size_t ... I> void spawnRules(std::index_sequence<I ...>);
+    template <int L, size_t I> void spawnRule();
+    typedef void (Skeet::*Spawner)();
+    template <size_t ... L>
+    static constexpr std::array<Spawner, sizeof...(L)> spawnersFor(std::index_sequence<L ...>)
+    {
+       return { { &Skeet::spawnLevel<L> ... } };
+    }
+    static const std::array<Spawner, NUM_LEVELS + 1> spawners;
+    void detectHits();
+
+    // put a new bird or bullet in play, enroll one already placed in its
+    // roster, or work out again when it will leave the screen. It last
+    // moved on frame last and cannot be looked at before frame earliest.
+    template <class T> void launch(const T & thing, unsigned int last, unsigned int earliest);
+    template <class T> void enroll(T & thing, size_t place, unsigned int last, unsigned int earliest);
+    template <class T> void expect(T & thing, unsigned int last, unsigned int earliest);
+
+    // a bird or bullet, by its handle and its place in the roster
+    struct Tag { Handle handle; unsigned char kind; };
+    template <class R, class T> static Tag tagOf(const T & thing)
+    {
+       return { thing.getHandle(), (unsigned char)R::template indexOf<T>() };
+    }
+    template <class R, class F> void find(R & roster, const Tag & tag, F f);
+
+    // where each kind of bird or bullet is, by handle
+    SlotMap * slotsFor(const Birds &)   { return birdSlots;   }
+    SlotMap * slotsFor(const Bullets &) { return bulletSlots; }
+
+    // where the census counts each kind of bird or bullet
+    static int censusOf(const Birds &)   { return Census::STANDARD; }
+    static int censusOf(const Bullets &) { return Census::PELLET;   }
+
+    // take the dead out of a roster, letting go of their handles
+    template <class R, class P> void remove(R & roster, P p);
+
+    // everything in the roster that was due to leave the screen this frame
+    template <class R> void expire(R & roster, TimerWheel<Tag> & wheel);
+
+    // effects and points, each put on the wheel for the frame it dies.
+    // An effect last aged on frame last.
+    void addEffect(Effect * effect, unsigned int last);
+    void addPoints(const Points & pts);
+
+    // put in play what was staged while the rosters were being walked
+    void commit();
+
+    // tell the census how many of each kind there are and what they hold
+    void takeCensus();
 
     Gun gun;                       // the gun
-    std::list<Bird*> birds;        // all the shootable birds
-    std::list<Bullet*> bullets;    // the bullets
-    std::list<Effect*> effects;    // the fragments of a dead bird.
-    std::list<Points>  points;     // point values;
+    Birds birds;                   // all the shootable birds
+    Bullets bullets;               // the bullets
+    SlotMap birdSlots[Birds::NUM_KINDS];      // where each bird is, by handle
+    SlotMap bulletSlots[Bullets::NUM_KINDS];  // where each bullet is
+    Bullets stagedBullets;                // shrapnel waiting for commit()
+    std::vector<Effect*> stagedEffects;   // fragments waiting for commit()
+    std::vector<Points> stagedPoints;     // point values waiting for commit()
+    Arena arena;                   // the fragments of this level
+    std::vector<Effect*> effects;  // the fragments of a dead bird.
+    Smokes smoke;                  // the trails of bullets that are gone
+    struct Contact { unsigned int bird; unsigned int bullet; };
+    std::vector<Bird *>   targets;  // every bird, in order, for hit detection
+    std::vector<Bullet *> shots;    // every live bullet, in order, for hit detection
+    std::vector<Vec2d>    shotAt;   // ... where each one is
+    std::vector<Vec2d>    shotMove; // ... how far it moves in a frame
+    std::vector<double>   shotRadius;
+    std::vector<std::vector<Contact>> contacts; // what each chunk of birds touched
+    TimerWheel<Tag> birdExits;     // when each bird should leave the screen
+    TimerWheel<Tag> bulletExits;   // when each bullet should
+    TimerWheel<Tag> bulletDeaths;  // when bombs and shrapnel run out of time
+    TimerWheel<Effect *> effectDeaths;                    // when each effect fades out
+    TimerWheel<int> pointDeaths;   // ... and each point value, by its value
+    std::vector<Points> points;    // point values, oldest first
+    std::vector<size_t> arenaPeaks;  // getArenaPeak() of each level
+    Census census;                 // how many of each kind, and what they hold
+    std::shared_ptr<const Tuning> pTuning;   // the numbers, never changed, only replaced
+    std::shared_ptr<const LevelTable> pLevels;   // from setLevels(), over any tuning
+    Chance spawns[MAX_SPAWN_RULES];  // when each of the level's rules next comes true
     Time time;                     // how many frames have transpired since the beginning
     Score score;                   // the player's score
     HitRatio hitRatio;             // the hit ratio for the birds
     Position dimensions;           // size of the screen
     bool bullseye;
+    unsigned int frame;            // number of calls to animate()
+    JobSystem & jobs;              // the threads that share the work of animate()
 };
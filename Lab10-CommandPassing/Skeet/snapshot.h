@@ -0,0 +1,65 @@
+/***********************************************************************
+ * Header File:
+ *    SNAPSHOT : Everything needed to draw one frame of Skeet
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    A copy of the game as it stood at the end of one frame: where
+ *    everything is, how big it is, what color it is, and what the
+ *    scoreboard says. The simulation fills one in and never touches it
+ *    again, so it can be drawn on another thread.
+ ************************************************************************/
+
+#pragma once
+
+#include "position.h"
+#include "bird.h"
+#include "bullet.h"
+#include "effect.h"
+#include "gun.h"
+#include "time.h"
+#include "score.h"
+#include "points.h"
+#include "roster.h"
+
+#include <chrono>
+#include <vector>
+
+/*************************************************************************
+ * SNAPSHOT
+ * One frame of the game, ready to draw
+ *************************************************************************/
+class Snapshot
+{
+public:
+   Snapshot() : gun(Position(800.0, 0.0)), bullseye(false), frame(0), hasInput(false) {}
+
+   // is the game playing in this frame?
+   bool isPlaying() const { return time.isPlaying(); }
+
+   // output everything on the screen
+   void drawLevel()  const;    // output the game
+   void drawStatus() const;    // output the status information
+
+   Position dimensions;        // size of the screen
+   Gun gun;
+   bool bullseye;
+   Time time;
+   Score score;
+   HitRatio hitRatio;
+   Roster<Standard, Floater, Sinker, Crazy> birds;
+   Roster<Pellet, Missile, Bomb, Shrapnel>  bullets;
+   EffectCopies effects;
+   std::vector<Points> points;
+   unsigned int frame;                                // which frame this is
+   std::chrono::steady_clock::time_point published;   // when it was finished
+   bool hasInput;                                     // did this frame take key events?
+   std::chrono::steady_clock::time_point input;       // when the earliest one arrived
+
+private:
+   void drawBackground(double redBack, double greenBack, double blueBack) const;
+   void drawTimer(double percent,
+                  double redFore, double greenFore, double blueFore,
+                  double redBack, double greenBack, double blueBack) const;
+   void drawBullseye(double angle) const;
+};
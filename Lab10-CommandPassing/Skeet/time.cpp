@@ -11,20 +11,32 @@
 #include <sstream>
 using namespace std;
 
-#define SECONDS_STATUS 5.0
+#define SECONDS_STATUS ((double)STATUS_SECONDS)
 
 /************************
  * TIME reset
- * Set up the levels and stuff
+ * Back to the start of the first level
  ************************/
 void Time::reset()
 {
-    // first level is 30 seconds in length, the first 5 are the status time
-    levelLength = {0, 30, 30, 45, 45};
     levelNumber = 1;
     framesLeft = FRAMES_PER_SECOND * levelLength[levelNumber];
 }
 
+/************************
+ * TIME SET LENGTHS
+ * How long each level is, the first 5 seconds being the status time.
+ * A level that gets shorter than the time already had ends next frame
+ ************************/
+void Time::setLengths(const LevelTable & levels)
+{
+    framesLeft += FRAMES_PER_SECOND * (levels[levelNumber].seconds - levelLength[levelNumber]);
+    if (framesLeft < 0)
+        framesLeft = 0;
+    for (size_t level = 0; level < levels.size(); level++)
+        levelLength[level] = levels[level].seconds;
+}
+
 /************************
  * TIME IS PLAYING
  * Are we currently in a game playing time?
@@ -90,7 +102,7 @@ bool Time::isStartLevel() const
  * TIME ADVANCE
  * Advance the time counter by one frame
  ************************/
-void Time::operator++(int postfix)
+void Time::operator++(int)
 {
     assert(levelNumber >= 0 && levelNumber < (int)levelLength.size());
     
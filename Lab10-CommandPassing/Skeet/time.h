@@ -8,6 +8,7 @@
  ************************************************************************/
 
 #pragma once
+#include "levels.h"
 #include <array>
 #include <string>
 #include <cassert>
@@ -21,7 +22,11 @@
 class Time
 {
 public:
-    Time() { reset(); }
+    Time(const LevelTable & levels = LEVELS) : framesLeft(0), levelNumber(0), levelLength()
+    {
+        setLengths(levels);
+        reset();
+    }
     
     // which level are we in?
     int level() const  { return levelNumber; }
@@ -53,6 +58,10 @@ public:
     // reset
     void reset();
 
+    // take the length of each level from a table. The level being
+    // played keeps the time it has had so far
+    void setLengths(const LevelTable & levels);
+
 private:
     // number of frames left in this level
     int framesLeft;
@@ -61,7 +70,7 @@ private:
     int levelNumber;
     
     // length in seconds of each level
-    std::array<int, 5> levelLength;
+    std::array<int, NUM_LEVELS + 1> levelLength;
     
     // seconds from frames
     int secondsFromFrames(int frame) const
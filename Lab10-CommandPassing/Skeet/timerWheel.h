@@ -0,0 +1,117 @@
+/***********************************************************************
+ * Header File:
+ *    TIMER WHEEL : Things to look at again on a given frame
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Something due on a frame is put in a slot for that frame, and each
+ *    frame only its own slot is looked at, so the cost is the number of
+ *    things due rather than the number of things there are. The wheel
+ *    is hierarchical: the first ring has a slot for each of the next 64
+ *    frames, the second a slot for each of the next 64 runs of 64, and
+ *    so on. When a ring comes around, the next slot of the ring above
+ *    is spread out over the ring below. Anything due past the last ring
+ *    is parked there and spread out again when its lap comes up.
+ ************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+/*********************************************
+ * TIMER WHEEL
+ * When each T is due
+ *********************************************/
+template <class T>
+class TimerWheel
+{
+public:
+   TimerWheel() : now(0), numTimers(0), rings(LEVELS * SLOTS) {}
+
+   // look at t again on this frame, which is no earlier than the one
+   // expire() will see next
+   void schedule(unsigned int frame, const T & t)
+   {
+      place({ frame, t });
+      numTimers++;
+   }
+
+   // everything due on this frame, handed to f. Frames go forward one at
+   // a time; any frames skipped since the last call are caught up first.
+   // f may schedule more, but only for later frames.
+   template <class F>
+   void expire(unsigned int frame, F f)
+   {
+      if (numTimers == 0)
+         now = frame;
+      for (; now <= frame; now++)
+      {
+         cascade();
+         due.swap(rings[now & MASK]);
+         numTimers -= due.size();
+         for (auto & timer : due)
+            f(timer.t);
+         due.clear();
+      }
+   }
+
+   // forget everything
+   void clear()
+   {
+      for (auto & slot : rings)
+         slot.clear();
+      numTimers = 0;
+   }
+
+   // how many things are waiting
+   size_t size() const { return numTimers; }
+
+private:
+   static const unsigned int BITS   = 6;
+   static const unsigned int SLOTS  = 1 << BITS;
+   static const unsigned int MASK   = SLOTS - 1;
+   static const unsigned int LEVELS = 3;
+
+   struct Timer
+   {
+      unsigned int frame;
+      T t;
+   };
+
+   // the slot for a timer, given the frame we are on
+   void place(const Timer & timer)
+   {
+      unsigned int ahead = timer.frame - now;
+      for (unsigned int level = 0; level < LEVELS; level++)
+         if (ahead < (1u << (BITS * (level + 1))))
+         {
+            rings[level * SLOTS + ((timer.frame >> (BITS * level)) & MASK)].push_back(timer);
+            return;
+         }
+
+      // beyond the last ring: the slot of it that comes up last
+      unsigned int top = BITS * (LEVELS - 1);
+      rings[(LEVELS - 1) * SLOTS + (((now >> top) - 1) & MASK)].push_back(timer);
+   }
+
+   // when a ring comes around, spread the next slot above over it
+   void cascade()
+   {
+      for (unsigned int level = 1; level < LEVELS; level++)
+      {
+         if (now & ((1u << (BITS * level)) - 1))
+            return;
+         spread.swap(rings[level * SLOTS + ((now >> (BITS * level)) & MASK)]);
+         for (auto & timer : spread)
+            place(timer);
+         spread.clear();
+      }
+   }
+
+   unsigned int now;                  // the frame expire() will see next
+   size_t numTimers;
+   std::vector<std::vector<Timer>> rings;
+   std::vector<Timer> due;            // the slot being handed out
+   std::vector<Timer> spread;         // the slot being spread out
+};
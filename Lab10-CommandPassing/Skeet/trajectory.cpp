@@ -0,0 +1,151 @@
+/***********************************************************************
+ * Source File:
+ *    TRAJECTORY : Where something will be, and when it leaves the screen
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Every bird and bullet changes its velocity the same way each frame:
+ *    a little drag, perhaps a push up or down, then a move. That can be
+ *    summed up in closed form, so the frame a thing leaves the screen
+ *    can be worked out once, when it is launched, instead of checked
+ *    every frame.
+ ************************************************************************/
+
+#include "trajectory.h"
+#include <cmath>
+using namespace std;
+
+// the closed form and the frame-by-frame sum differ by far less than
+// this, so a box this much smaller is always left no later
+const double EPSILON = 1.0e-6;
+
+// past this, a thing is taken to never leave
+const double HORIZON = 16777216.0;
+
+/*********************************************
+ * AXIS
+ * One coordinate of a flight: where it is after n moves and which
+ * way each move goes. With u(k) the k'th move,
+ *    drag == 1 : u(k) = v0 + lift + (k - 1) g
+ *    drag <  1 : u(k) = c + e drag^k, heading for c / (1 - drag)
+ * where g is lift + buoyancy, the whole change each frame.
+ *********************************************/
+class Axis
+{
+public:
+   Axis(double p0, double v0, double drag, double lift, double buoyancy) :
+      p0(p0), v0(v0), drag(drag), lift(lift), g(lift + buoyancy), c(0.0), e(0.0)
+   {
+      if (drag < 1.0)
+      {
+         double terminal = g / (1.0 - drag);
+         c = drag * terminal + lift;
+         e = v0 - terminal;
+      }
+   }
+
+   // where it is after n moves
+   double at(double n) const
+   {
+      if (drag == 1.0)
+         return p0 + n * (v0 + lift) + g * n * (n - 1.0) / 2.0;
+      return p0 + n * c + e * drag * (1.0 - pow(drag, n)) / (1.0 - drag);
+   }
+
+   // the n'th move
+   double move(double n) const
+   {
+      if (drag == 1.0)
+         return v0 + lift + (n - 1.0) * g;
+      return c + e * pow(drag, n);
+   }
+
+   // the move after which it turns around, or 0 if it never does
+   double turn() const
+   {
+      double k = 0.0;
+      if (drag == 1.0 && g != 0.0)
+         k = 1.0 - (v0 + lift) / g;
+      else if (drag < 1.0 && e != 0.0 && -c / e > 0.0)
+         k = log(-c / e) / log(drag);
+      return k > 1.0 && k < HORIZON ? floor(k) : 0.0;
+   }
+
+private:
+   double p0, v0, drag, lift, g, c, e;
+};
+
+/*********************************************
+ * FIRST OUT
+ * The first move from begin through end (end may be HORIZON) after
+ * which the axis is out of [low, high), or HORIZON if none. After the
+ * move at begin, the axis must only go one way for the rest.
+ *********************************************/
+static double firstOut(const Axis & axis, double begin, double end, double low, double high)
+{
+   double p = axis.at(begin);
+   if (p < low || p >= high)
+      return begin;
+   double direction = axis.move(end == HORIZON ? begin + 1.0 : begin);
+   if (begin >= end || direction == 0.0)
+      return HORIZON;
+   auto isOut = [&](double n)
+   {
+      return direction > 0.0 ? axis.at(n) >= high : axis.at(n) < low;
+   };
+
+   // gallop out to something past the edge, then close in on it
+   double in = begin;
+   double out = begin + 1.0;
+   double step = 1.0;
+   while (!isOut(out))
+   {
+      if (out >= end)
+         return HORIZON;
+      in = out;
+      step *= 2.0;
+      out = min(end, in + step);
+   }
+   while (out - in > 1.0)
+   {
+      double middle = floor((in + out) / 2.0);
+      if (isOut(middle))
+         out = middle;
+      else
+         in = middle;
+   }
+   return out;
+}
+
+/*********************************************
+ * FIRST EXIT
+ * The first move after which one axis is out of [low, high). It goes
+ * one way until it turns, if it turns, then the other way for good.
+ *********************************************/
+static double firstExit(const Axis & axis, double low, double high)
+{
+   double turn = axis.turn();
+   if (turn == 0.0)
+      return firstOut(axis, 1.0, HORIZON, low, high);
+   double n = firstOut(axis, 1.0, turn, low, high);
+   return n != HORIZON ? n : firstOut(axis, turn, HORIZON, low, high);
+}
+
+/*********************************************
+ * FRAMES TO EXIT
+ * The sooner of the two axes to leave
+ *********************************************/
+unsigned int framesToExit(const Position & pt, const Velocity & v, double radius,
+                          const Flight & flight, const Position & dimensions)
+{
+   double low = -radius + EPSILON;
+   double highX = dimensions.getX() + radius - EPSILON;
+   double highY = dimensions.getY() + radius - EPSILON;
+   if (pt.getX() < low || pt.getX() >= highX || pt.getY() < low || pt.getY() >= highY)
+      return 0;
+
+   Axis x(pt.getX(), v.getDx(), flight.drag, 0.0, 0.0);
+   Axis y(pt.getY(), v.getDy(), flight.drag, flight.lift, flight.buoyancy);
+   double n = min(firstExit(x, low, highX), firstExit(y, low, highY));
+   return n >= HORIZON ? NEVER : (unsigned int)n;
+}
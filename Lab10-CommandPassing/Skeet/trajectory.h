@@ -0,0 +1,41 @@
+/***********************************************************************
+ * Header File:
+ *    TRAJECTORY : Where something will be, and when it leaves the screen
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Every bird and bullet changes its velocity the same way each frame:
+ *    a little drag, perhaps a push up or down, then a move. That can be
+ *    summed up in closed form, so the frame a thing leaves the screen
+ *    can be worked out once, when it is launched, instead of checked
+ *    every frame.
+ ************************************************************************/
+
+#pragma once
+
+#include "position.h"
+
+/*********************************************
+ * FLIGHT
+ * How the velocity changes each frame, in this order:
+ *    v = v * drag + lift;   pt += v;   v += buoyancy
+ *********************************************/
+struct Flight
+{
+   double drag;       // fraction of the velocity kept
+   double lift;       // added to dy before the move
+   double buoyancy;   // added to dy after the move
+};
+
+// a thing that will never leave the screen, left as it is
+const unsigned int NEVER = 0xffffffff;
+
+/*********************************************
+ * FRAMES TO EXIT
+ * How many more moves until something at pt, going v, is out of
+ * the screen as Bird::isOutOfBounds() sees it. 0 means it already is.
+ * The answer is never late, but may be a frame early when it only
+ * just grazes the edge; check isOutOfBounds() when the time comes.
+ *********************************************/
+unsigned int framesToExit(const Position & pt, const Velocity & v, double radius,
+                          const Flight & flight, const Position & dimensions);
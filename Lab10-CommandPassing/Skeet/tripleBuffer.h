@@ -0,0 +1,52 @@
+/***********************************************************************
+ * Header File:
+ *    TRIPLE BUFFER : Hand the newest copy of something to another thread
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    One thread writes, another reads, and neither ever waits. The writer
+ *    fills the back slot and swaps it into the middle. The reader swaps
+ *    the middle into the front, but only if something new is there. The
+ *    reader always has a complete copy. If the writer is faster, copies
+ *    the reader never saw are simply overwritten.
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>
+
+/*********************************************
+ * TRIPLE BUFFER
+ * Three copies of T shared by one writer and one reader
+ *********************************************/
+template <class T>
+class TripleBuffer
+{
+public:
+   TripleBuffer() : iFront(0), iBack(1), middle(2) {}
+
+   // writer: the copy to fill in, then hand it over
+   T & back() { return slots[iBack]; }
+   void publish()
+   {
+      iBack = middle.exchange(iBack | FRESH, std::memory_order_acq_rel) & INDEX;
+   }
+
+   // reader: pick up the newest copy, if there is one. False if not.
+   bool update()
+   {
+      if (!(middle.load(std::memory_order_acquire) & FRESH))
+         return false;
+      iFront = middle.exchange(iFront, std::memory_order_acq_rel) & INDEX;
+      return true;
+   }
+   const T & front() const { return slots[iFront]; }
+
+private:
+   enum { INDEX = 3, FRESH = 4 };   // the middle is an index and a "new" flag
+
+   T slots[3];
+   int iFront;                      // belongs to the reader
+   int iBack;                       // belongs to the writer
+   std::atomic<int> middle;         // passed back and forth
+};
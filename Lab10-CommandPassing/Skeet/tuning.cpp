@@ -0,0 +1,330 @@
+/***********************************************************************
+ * Source File:
+ *    TUNING : The numbers a designer turns while the game is running
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    Mapping, checking, and writing tuning files, reading and writing
+ *    their text form, and watching a file for a new version
+ ************************************************************************/
+
+#include "tuning.h"
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // !_WIN32
+
+using namespace std;
+
+/*********************************************
+ * HEADER
+ * What starts a tuning file. The size tells an old file from a
+ * new one when the block has gained or lost a number, and the
+ * block itself starts at the next 8 bytes
+ *********************************************/
+struct Header
+{
+   char magic[4];
+   unsigned int size;
+};
+static const char MAGIC[4] = { 'S', 'K', 'T', '1' };
+static_assert(sizeof(Header) % alignof(Tuning) == 0, "the block would not be aligned");
+
+// the numbers by name, for the text form
+static const struct { const char * name; double Tuning::*number; } REALS[] =
+{
+   { "standardDrag",     &Tuning::standardDrag     },
+   { "floaterDrag",      &Tuning::floaterDrag      },
+   { "floaterBuoyancy",  &Tuning::floaterBuoyancy  },
+   { "sinkerGravity",    &Tuning::sinkerGravity    },
+   { "pelletSpeed",      &Tuning::pelletSpeed      },
+   { "missileSpeed",     &Tuning::missileSpeed     },
+   { "bombSpeed",        &Tuning::bombSpeed        },
+   { "shrapnelSpeedMin", &Tuning::shrapnelSpeedMin },
+   { "shrapnelSpeedMax", &Tuning::shrapnelSpeedMax },
+};
+static const struct { const char * name; int Tuning::*number; } COUNTS[] =
+{
+   { "shrapnelPerBomb",  &Tuning::shrapnelPerBomb  },
+   { "fragmentsPerHit",  &Tuning::fragmentsPerHit  },
+};
+
+// the fastest bullet, the strongest pull on a bird, and the most
+// pieces from one bomb or hit, that make sense
+const double MAX_SPEED  = 100.0;
+const double MAX_PULL   = 1.0;
+const int    MAX_PIECES = 200;
+
+/*********************************************
+ * IS VALID
+ * Nothing in the block would send the game out of bounds:
+ * every level and spawn rule is one the game can play, every
+ * bullet goes forward, and no number is out of reason. Each
+ * test is written so a NaN fails it
+ *********************************************/
+static bool isValid(const Tuning & tuning)
+{
+   if (!(tuning.standardDrag > 0.0 && tuning.standardDrag <= 1.0) ||
+       !(tuning.floaterDrag  > 0.0 && tuning.floaterDrag  <= 1.0) ||
+       !(tuning.floaterBuoyancy >= 0.0 && tuning.floaterBuoyancy <= MAX_PULL) ||
+       !(tuning.sinkerGravity   >= 0.0 && tuning.sinkerGravity   <= MAX_PULL))
+      return false;
+
+   if (!(tuning.pelletSpeed  > 0.0 && tuning.pelletSpeed  <= MAX_SPEED) ||
+       !(tuning.missileSpeed > 0.0 && tuning.missileSpeed <= MAX_SPEED) ||
+       !(tuning.bombSpeed    > 0.0 && tuning.bombSpeed    <= MAX_SPEED) ||
+       !(tuning.shrapnelSpeedMin > 0.0 &&
+         tuning.shrapnelSpeedMin <= tuning.shrapnelSpeedMax &&
+         tuning.shrapnelSpeedMax <= MAX_SPEED))
+      return false;
+
+   if (tuning.shrapnelPerBomb < 0 || tuning.shrapnelPerBomb > MAX_PIECES ||
+       tuning.fragmentsPerHit < 0 || tuning.fragmentsPerHit > MAX_PIECES)
+      return false;
+
+   return isPlayable(tuning.levels);
+}
+
+/*********************************************
+ * BUILT IN TUNING
+ * TUNING itself; nothing is owned, so nothing is freed
+ *********************************************/
+shared_ptr<const Tuning> builtInTuning()
+{
+   return shared_ptr<const Tuning>(shared_ptr<const Tuning>(), &TUNING);
+}
+
+/*********************************************
+ * LOAD TUNING
+ * Map the file and check the block where it lies. Without mmap()
+ * the file is read into memory instead
+ *********************************************/
+shared_ptr<const Tuning> loadTuning(const string & fileName)
+{
+   const size_t size = sizeof(Header) + sizeof(Tuning);
+   shared_ptr<const char> pFile;
+
+#ifndef _WIN32
+   int fd = open(fileName.c_str(), O_RDONLY);
+   if (fd < 0)
+      return nullptr;
+   struct stat st;
+   if (fstat(fd, &st) != 0 || (size_t)st.st_size != size)
+   {
+      close(fd);
+      return nullptr;
+   }
+   void * p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);                   // the mapping keeps the file open
+   if (p == MAP_FAILED)
+      return nullptr;
+   pFile = shared_ptr<const char>((const char *)p, [size](const char * p)
+   {
+      munmap((void *)p, size);
+   });
+#else // _WIN32
+   ifstream fin(fileName, ios::binary);
+   shared_ptr<char> pRead(new char[size + 1], default_delete<char[]>());
+   fin.read(pRead.get(), size + 1);
+   if (fin.gcount() != (streamsize)size)
+      return nullptr;
+   pFile = pRead;
+#endif // _WIN32
+
+   const Header * pHeader = (const Header *)pFile.get();
+   if (memcmp(pHeader->magic, MAGIC, sizeof(MAGIC)) != 0 || pHeader->size != sizeof(Tuning))
+      return nullptr;
+   const Tuning * pTuning = (const Tuning *)(pFile.get() + sizeof(Header));
+   if (!isValid(*pTuning))
+      return nullptr;
+
+   // the block shares the mapping's life
+   return shared_ptr<const Tuning>(pFile, pTuning);
+}
+
+/*********************************************
+ * WRITE TUNING
+ * Write the whole file under another name first, then rename it
+ * over the old one. Whoever has the old one mapped keeps it
+ *********************************************/
+bool writeTuning(const string & fileName, const Tuning & tuning)
+{
+   if (!isValid(tuning))
+      return false;
+
+   string tempName = fileName + ".new";
+   {
+      ofstream fout(tempName, ios::binary | ios::trunc);
+      Header header;
+      memcpy(header.magic, MAGIC, sizeof(MAGIC));
+      header.size = sizeof(Tuning);
+      fout.write((const char *)&header, sizeof(header));
+      fout.write((const char *)&tuning, sizeof(tuning));
+      if (!fout)
+         return false;
+   }
+   error_code error;
+   filesystem::rename(tempName, fileName, error);
+   return !error;
+}
+
+/*********************************************
+ * READ TUNING
+ * A line per number, by name, and then the level table in the
+ * form readLevels() takes. Anything left out keeps the value it
+ * had. The whole text is checked before tuning is changed
+ *********************************************/
+bool readTuning(istream & in, Tuning & tuning)
+{
+   Tuning read = tuning;
+   stringstream levels;
+   bool isLevels = false;
+   string line;
+   while (getline(in, line))
+   {
+      istringstream sin(line);
+      string word;
+      if (!(sin >> word) || word[0] == '#')
+         continue;
+
+      if (word == "level" || word == "spawn")
+      {
+         levels << line << '\n';
+         isLevels = true;
+         continue;
+      }
+
+      bool isFound = false;
+      for (auto & real : REALS)
+         if (word == real.name)
+            isFound = (bool)(sin >> read.*real.number);
+      for (auto & count : COUNTS)
+         if (word == count.name)
+            isFound = (bool)(sin >> read.*count.number);
+      if (!isFound)
+         return false;
+   }
+
+   if ((isLevels && !readLevels(levels, read.levels)) || !isValid(read))
+      return false;
+   tuning = read;
+   return true;
+}
+
+/*********************************************
+ * WRITE TUNING TEXT
+ * Every number, then the level table, as readTuning() takes them
+ *********************************************/
+void writeTuningText(ostream & out, const Tuning & tuning)
+{
+   // the shortest text that reads back as the very same number
+   for (auto & real : REALS)
+   {
+      char text[32];
+      *to_chars(text, text + sizeof(text) - 1, tuning.*real.number).ptr = '\0';
+      out << real.name << ' ' << text << '\n';
+   }
+   for (auto & count : COUNTS)
+      out << count.name << ' ' << tuning.*count.number << '\n';
+   writeLevels(out, tuning.levels);
+}
+
+/*********************************************
+ * TUNING WATCHER constructor
+ * Load what is there now and start watching
+ *********************************************/
+TuningWatcher::TuningWatcher(const string & fileName, chrono::milliseconds period) :
+   fileName(fileName), period(period), isPending(false), isStopping(false)
+{
+   if (!stamp(last))
+      last = { 0, 0 };
+   pFirst = loadTuning(fileName);
+   watcher = thread(&TuningWatcher::watch, this);
+}
+
+/*********************************************
+ * TUNING WATCHER destructor
+ * Wake the watcher up and wait for it to go
+ *********************************************/
+TuningWatcher::~TuningWatcher()
+{
+   {
+      lock_guard<mutex> guard(lock);
+      isStopping = true;
+   }
+   wake.notify_one();
+   watcher.join();
+}
+
+/*********************************************
+ * TUNING WATCHER : TAKE
+ * The newest block that is ready, if there is one
+ *********************************************/
+shared_ptr<const Tuning> TuningWatcher::take()
+{
+   if (!isPending.load(memory_order_acquire))
+      return nullptr;
+   lock_guard<mutex> guard(lock);
+   isPending.store(false, memory_order_relaxed);
+   return std::move(pending);
+}
+
+/*********************************************
+ * TUNING WATCHER : STAMP
+ * When the file was last written, and how big it is
+ *********************************************/
+bool TuningWatcher::stamp(Stamp & s) const
+{
+   error_code error;
+   auto modified = filesystem::last_write_time(fileName, error);
+   if (error)
+      return false;
+   auto size = filesystem::file_size(fileName, error);
+   if (error)
+      return false;
+   s = { (long long)modified.time_since_epoch().count(), (unsigned long long)size };
+   return true;
+}
+
+/*********************************************
+ * TUNING WATCHER : WATCH
+ * Every period, see whether the file changed. A file that is not
+ * a good tuning file, perhaps because it is half written, is
+ * passed over until it changes again, and the game keeps the
+ * block it has
+ *********************************************/
+void TuningWatcher::watch()
+{
+   unique_lock<mutex> guard(lock);
+   while (!wake.wait_for(guard, period, [this] { return isStopping; }))
+   {
+      guard.unlock();
+      Stamp now;
+      shared_ptr<const Tuning> pTuning;
+      if (stamp(now) && now != last)
+      {
+         last = now;
+         pTuning = loadTuning(fileName);
+         if (!pTuning)
+            cerr << "Unable to read tuning " << fileName
+                 << ", keeping the last one" << endl;
+      }
+      guard.lock();
+
+      if (pTuning)
+      {
+         pending = pTuning;
+         isPending.store(true, memory_order_release);
+      }
+   }
+}
@@ -0,0 +1,146 @@
+/***********************************************************************
+ * Header File:
+ *    TUNING : The numbers a designer turns while the game is running
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    How birds fall and drift, how fast each bullet goes, how many
+ *    pieces a hit or a bomb makes, and the level table, all in one block
+ *    that never changes once it is made. The game holds on to one block
+ *    and a new one takes its place between frames, so a frame always
+ *    sees one consistent set of numbers.
+ *
+ *    A tuning file is a small header followed by the block itself, just
+ *    as it sits in memory on this machine. Loading one maps the file and
+ *    uses the block where it lies, so there is nothing to parse. Because
+ *    the mapping is still in use, a new file should be written next to
+ *    the old one and renamed over it, as writeTuning() does. The text
+ *    form, for people, is the level table of levels.h with a line per
+ *    number on top, like "standardDrag 0.995".
+ ************************************************************************/
+
+#pragma once
+
+#include "levels.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+/*********************************************
+ * TUNING
+ * Every number that can be changed without building again
+ *********************************************/
+struct Tuning
+{
+   // birds
+   double standardDrag;       // speed kept each frame
+   double floaterDrag;
+   double floaterBuoyancy;    // up, each frame
+   double sinkerGravity;      // down, each frame
+
+   // bullets
+   double pelletSpeed;
+   double missileSpeed;
+   double bombSpeed;
+   double shrapnelSpeedMin;
+   double shrapnelSpeedMax;
+   int    shrapnelPerBomb;
+
+   // effects
+   int    fragmentsPerHit;
+
+   LevelTable levels;
+};
+
+// the block is the file, so it has to be nothing but bytes
+static_assert(std::is_trivially_copyable<Tuning>::value, "a tuning file is a copy of the bytes");
+
+/*********************************************
+ * TUNING
+ * The numbers the game ships with
+ *********************************************/
+constexpr Tuning TUNING =
+{
+   0.995,         // small amount of drag
+   0.990,         // large amount of drag
+   0.05,          // anti-gravity
+   0.07,
+   15.0,
+   10.0,
+   10.0,
+   10.0,
+   15.0,
+   20,
+   25,
+   LEVELS
+};
+
+// the built-in numbers, shared the same way a loaded block is
+std::shared_ptr<const Tuning> builtInTuning();
+
+// map a tuning file, or nullptr if it is not one. The block stays
+// mapped until the last copy of the pointer is gone
+std::shared_ptr<const Tuning> loadTuning(const std::string & fileName);
+
+// write a tuning file without disturbing one that is mapped
+bool writeTuning(const std::string & fileName, const Tuning & tuning);
+
+// the text form, read over a copy of what is there already
+bool readTuning(std::istream & in, Tuning & tuning);
+void writeTuningText(std::ostream & out, const Tuning & tuning);
+
+/*********************************************
+ * TUNING WATCHER
+ * Looks at a tuning file a few times a second on its own
+ * thread. When the file changes, the new block is mapped
+ * and checked there, and handed over by take(); the
+ * simulation only ever picks up a block that is ready.
+ *********************************************/
+class TuningWatcher
+{
+public:
+   TuningWatcher(const std::string & fileName,
+                 std::chrono::milliseconds period = std::chrono::milliseconds(250));
+   ~TuningWatcher();
+   TuningWatcher(const TuningWatcher &) = delete;
+
+   // the block the file held at the start, or nullptr if it held none
+   std::shared_ptr<const Tuning> first() const { return pFirst; }
+
+   // simulation thread, between frames: a block newer than the last
+   // one taken, or nullptr. Costs one atomic load when there is none
+   std::shared_ptr<const Tuning> take();
+
+private:
+   void watch();                      // the watcher thread's life
+
+   struct Stamp                       // enough to tell the file changed
+   {
+      long long modified;
+      unsigned long long size;
+      bool operator != (const Stamp & rhs) const
+      {
+         return modified != rhs.modified || size != rhs.size;
+      }
+   };
+   bool stamp(Stamp & s) const;       // false if the file is not there
+
+   std::string fileName;
+   std::chrono::milliseconds period;
+   std::shared_ptr<const Tuning> pFirst;
+   Stamp last;
+
+   std::mutex lock;                   // guards pending and isStopping
+   std::condition_variable wake;
+   std::shared_ptr<const Tuning> pending;
+   std::atomic<bool> isPending;
+   bool isStopping;
+   std::thread watcher;
+};
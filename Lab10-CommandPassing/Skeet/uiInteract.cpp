@@ -116,7 +116,7 @@ void drawCallback()
  *   INPUT   key:   the key we pressed according to the GLUT_KEY_ prefix
  *           x y:   the position in the window, which we ignore
  *************************************************************************/
-void keyDownCallback(int key, int x, int y)
+void keyDownCallback(int key, int /*x*/, int /*y*/)
 {
    // Even though this is a local variable, all the members are static
    // so we are actually getting the same version as in the constructor.
@@ -130,7 +130,7 @@ void keyDownCallback(int key, int x, int y)
  *   INPUT   key:   the key we pressed according to the GLUT_KEY_ prefix
  *           x y:   the position in the window, which we ignore
  *************************************************************************/
-void keyUpCallback(int key, int x, int y)
+void keyUpCallback(int key, int /*x*/, int /*y*/)
 {
    // Even though this is a local variable, all the members are static
    // so we are actually getting the same version as in the constructor.
@@ -143,7 +143,7 @@ void keyUpCallback(int key, int x, int y)
  * Generic callback to a regular ascii keyboard event, such as
  * the space bar or the letter 'q'
  ***************************************************************/
-void keyboardCallback(unsigned char key, int x, int y)
+void keyboardCallback(unsigned char key, int /*x*/, int /*y*/)
 {
    // Even though this is a local variable, all the members are static
    // so we are actually getting the same version as in the constructor.
@@ -195,6 +195,10 @@ void UserInput::keyEvent(int key, bool fDown)
    }
 
    isShiftPress = (glutGetModifiers () == GLUT_ACTIVE_SHIFT);
+
+   // pass it along, timestamped, for whoever is listening
+   if (pEvents)
+      pEvents->push({ key, fDown, isShiftPress, std::chrono::steady_clock::now() });
 }
 
 /***************************************************************
@@ -263,6 +267,7 @@ bool         UserInput::isSpacePress = false;
 bool         UserInput::isMPress     = false;
 bool         UserInput::isBPress     = false;
 bool         UserInput::isShiftPress = false;
+KeyEventQueue * UserInput::pEvents   = NULL;
 bool         UserInput::initialized  = false;
 double       UserInput::timePeriod   = 1.0 / 30; // default to 30 frames/second
 unsigned long UserInput::nextTick     = 0;        // redraw now please
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "position.h"
+#include "eventQueue.h"
 #include <algorithm> // used for min() and max() (specifically required by Visual Studio)
 using std::min;
 using std::max;
@@ -60,6 +61,9 @@ public:
    void keyEvent(int key, bool fDown);
    void keyEvent();
 
+   // Also send every key event, with the time it happened, to this queue
+   void setEventQueue(KeyEventQueue * pQueue) { pEvents = pQueue; }
+
    // Current frame rate
    double frameRate() const { return timePeriod;   }
    
@@ -91,6 +95,7 @@ private:
    static bool isBPress;             //    "   B          "
    static bool isMPress;             //    "   N          "
    static bool isShiftPress;         //    "   shift key  "
+   static KeyEventQueue * pEvents;   // where to send key events, if anywhere
 };
 
 
@@ -0,0 +1,137 @@
+/***********************************************************************
+ * Header File:
+ *    VEC2 : Two numbers that travel together
+ * Author:
+ *    Br. Helfrich
+ * Summary:
+ *    The core of Position and Velocity. It is a plain struct, so it
+ *    copies with memcpy and sits in arrays the compiler can vectorize.
+ *    A pair of doubles is aligned so it loads as one SSE2 register, and
+ *    each operation works on both at once where SSE2 is available. Every
+ *    operation does the same sums in the same order as writing out x
+ *    and y by hand, so results are identical to the last bit either way.
+ *
+ *    The game state is stored in Real, which is double unless the whole
+ *    program is built with SKEET_FLOAT32. Collision math widens to Vec2d
+ *    first, so only the storage gets smaller, not the answers it gives.
+ ************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VEC2_SSE2
+#endif // SSE2
+
+// what positions, velocities, sizes, and lifetimes are stored in
+#ifdef SKEET_FLOAT32
+typedef float Real;
+#else // !SKEET_FLOAT32
+typedef double Real;
+#endif // !SKEET_FLOAT32
+
+/*********************************************
+ * VEC2 OF
+ * An x and a y
+ *********************************************/
+template <class T>
+struct alignas(2 * sizeof(T)) Vec2Of
+{
+   T x;
+   T y;
+
+#ifdef VEC2_SSE2
+   // both doubles in one register
+   static constexpr bool isPacked = std::is_same<T, double>::value;
+   __m128d load() const           { return _mm_load_pd((const double *)&x); }
+   static Vec2Of from(__m128d m)  { Vec2Of v; _mm_store_pd((double *)&v.x, m); return v; }
+#else // !VEC2_SSE2
+   static constexpr bool isPacked = false;
+#endif // !VEC2_SSE2
+
+   Vec2Of & operator += (const Vec2Of & rhs)
+   {
+#ifdef VEC2_SSE2
+      if constexpr (isPacked)
+         return *this = from(_mm_add_pd(load(), rhs.load()));
+#endif // VEC2_SSE2
+      x += rhs.x;
+      y += rhs.y;
+      return *this;
+   }
+   Vec2Of & operator -= (const Vec2Of & rhs)
+   {
+#ifdef VEC2_SSE2
+      if constexpr (isPacked)
+         return *this = from(_mm_sub_pd(load(), rhs.load()));
+#endif // VEC2_SSE2
+      x -= rhs.x;
+      y -= rhs.y;
+      return *this;
+   }
+   Vec2Of & operator *= (T s)
+   {
+#ifdef VEC2_SSE2
+      if constexpr (isPacked)
+         return *this = from(_mm_mul_pd(load(), _mm_set1_pd(s)));
+#endif // VEC2_SSE2
+      x *= s;
+      y *= s;
+      return *this;
+   }
+};
+
+typedef Vec2Of<Real>   Vec2;    // what the game state is kept in
+typedef Vec2Of<double> Vec2d;   // what collisions are worked out in
+
+template <class T>
+inline Vec2Of<T> operator + (Vec2Of<T> lhs, const Vec2Of<T> & rhs) { return lhs += rhs; }
+template <class T>
+inline Vec2Of<T> operator - (Vec2Of<T> lhs, const Vec2Of<T> & rhs) { return lhs -= rhs; }
+template <class T>
+inline Vec2Of<T> operator * (Vec2Of<T> lhs, T s)                   { return lhs *= s;   }
+
+/*********************************************
+ * WIDEN
+ * A stored Vec2 as doubles; a plain copy when Real is double
+ *********************************************/
+inline Vec2d widen(const Vec2 & v)
+{
+   return { (double)v.x, (double)v.y };
+}
+
+/*********************************************
+ * DOT, LENGTH
+ * x * x' + y * y', and how long it is
+ *********************************************/
+template <class T>
+inline T dot(const Vec2Of<T> & a, const Vec2Of<T> & b)
+{
+#ifdef VEC2_SSE2
+   if constexpr (Vec2Of<T>::isPacked)
+   {
+      __m128d m = _mm_mul_pd(a.load(), b.load());
+      return _mm_cvtsd_f64(m) + _mm_cvtsd_f64(_mm_unpackhi_pd(m, m));
+   }
+#endif // VEC2_SSE2
+   return a.x * b.x + a.y * b.y;
+}
+template <class T>
+inline T length(const Vec2Of<T> & a)
+{
+   return std::sqrt(dot(a, a));
+}
+
+/*********************************************
+ * ROTATE
+ * Turn counterclockwise by the angle whose cosine and sine are given,
+ * so turning a whole array by one angle pays for the trig only once
+ *********************************************/
+template <class T>
+inline Vec2Of<T> rotate(const Vec2Of<T> & a, T cosine, T sine)
+{
+   return { a.x * cosine - a.y * sine, a.x * sine + a.y * cosine };
+}
@@ -9,7 +9,7 @@
 
 #pragma once
 #include "position.h"
-#include "applyMovement.h"
+#include "ApplyMovement.h"
 #include <vector>
 
 /**********************